@@ -0,0 +1,232 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/**
+ * Minimal host benchmark harness.
+ * Every benchmark executable is a single translation unit including this header,
+ * heap calls are counted by interposing the C allocator entry points.
+ */
+
+extern "C"
+{
+    void* __libc_malloc(size_t size);
+    void* __libc_calloc(size_t count, size_t size);
+    void* __libc_realloc(void* ptr, size_t size);
+    void __libc_free(void* ptr);
+}
+
+namespace Hyperion::Benchmark
+{
+    /**
+     * @brief Heap activity observed since the program started.
+     */
+    struct HeapCounter
+    {
+        static inline size_t allocations = 0; /**< Calls to malloc, calloc and realloc. */
+        static inline size_t frees = 0;       /**< Calls to free with a non-null pointer. */
+    };
+}
+
+extern "C" void* malloc(size_t size) noexcept
+{
+    Hyperion::Benchmark::HeapCounter::allocations++;
+    return __libc_malloc(size);
+}
+
+extern "C" void* calloc(size_t count, size_t size) noexcept
+{
+    Hyperion::Benchmark::HeapCounter::allocations++;
+    return __libc_calloc(count, size);
+}
+
+extern "C" void* realloc(void* ptr, size_t size) noexcept
+{
+    Hyperion::Benchmark::HeapCounter::allocations++;
+    return __libc_realloc(ptr, size);
+}
+
+extern "C" void free(void* ptr) noexcept
+{
+    if (ptr) Hyperion::Benchmark::HeapCounter::frees++;
+    __libc_free(ptr);
+}
+
+namespace Hyperion::Benchmark
+{
+    /**
+     * @brief Prevent the compiler from discarding a computed value.
+     * @param value The value to keep alive.
+     */
+    template <typename T>
+    inline void Consume(const T& value)
+    {
+        __asm__ volatile("" : : "g"(&value) : "memory");
+    }
+
+    /**
+     * @brief Deterministic xorshift generator, so every run sees the same data.
+     */
+    class Random
+    {
+        uint32_t state;
+
+    public:
+        Random(uint32_t seed = 0x9E3779B9u) : state(seed ? seed : 1) {}
+
+        uint32_t Next()
+        {
+            state ^= state << 13;
+            state ^= state >> 17;
+            state ^= state << 5;
+            return state;
+        }
+
+        /**
+         * @brief Get a value in the range [0, bound).
+         */
+        uint32_t Next(uint32_t bound) { return static_cast<uint32_t>((static_cast<uint64_t>(Next()) * bound) >> 32); }
+
+        /**
+         * @brief Shuffle an array in place (Fisher-Yates).
+         */
+        template <typename T>
+        void Shuffle(T* array, size_t count)
+        {
+            for (size_t i = count; i > 1; --i)
+            {
+                size_t j = Next(static_cast<uint32_t>(i));
+                T temp = array[i - 1];
+                array[i - 1] = array[j];
+                array[j] = temp;
+            }
+        }
+    };
+
+    /**
+     * @brief Accumulates time and heap calls between Start/Stop pairs of one sample.
+     */
+    class Stopwatch
+    {
+        uint64_t startTime = 0;
+        size_t startAllocations = 0;
+        uint64_t elapsed = 0;
+        size_t allocations = 0;
+
+        static uint64_t Now()
+        {
+            timespec time;
+            clock_gettime(CLOCK_MONOTONIC, &time);
+            return static_cast<uint64_t>(time.tv_sec) * 1000000000u + time.tv_nsec;
+        }
+
+    public:
+        void Start()
+        {
+            startAllocations = HeapCounter::allocations;
+            startTime = Now();
+        }
+
+        void Stop()
+        {
+            elapsed += Now() - startTime;
+            allocations += HeapCounter::allocations - startAllocations;
+        }
+
+        uint64_t Elapsed() const { return elapsed; }
+
+        size_t Allocations() const { return allocations; }
+    };
+
+    /**
+     * @brief Runs named benchmarks and prints one result line per benchmark.
+     *
+     * Each benchmark runs one warm-up sample followed by the configured number of measured
+     * samples; the minimum and median time per item are reported, together with the average
+     * number of heap calls per sample. Usage: <binary> [-r repetitions] [name filter].
+     */
+    class Suite
+    {
+        static constexpr size_t MaxRepetitions = 101;
+
+        size_t repetitions = 15;
+        const char* filter = nullptr;
+
+        static int CompareSamples(const void* a, const void* b)
+        {
+            const double lhs = *static_cast<const double*>(a);
+            const double rhs = *static_cast<const double*>(b);
+            return (lhs > rhs) - (lhs < rhs);
+        }
+
+    public:
+        Suite(int argc, char** argv, const char* title)
+        {
+            for (int i = 1; i < argc; i++)
+            {
+                if (!strcmp(argv[i], "-r") && i + 1 < argc)
+                {
+                    repetitions = static_cast<size_t>(atoi(argv[++i]));
+                }
+                else
+                {
+                    filter = argv[i];
+                }
+            }
+
+            if (repetitions < 1) repetitions = 1;
+            if (repetitions > MaxRepetitions) repetitions = MaxRepetitions;
+
+            printf("# %s (%zu samples, min/median per item)\n", title, repetitions);
+            printf("%-44s %8s %12s %12s %12s\n", "benchmark", "items", "min ns", "median ns", "allocs/run");
+        }
+
+        /**
+         * @brief Check whether a benchmark name passes the command line filter.
+         */
+        bool Enabled(const char* name) const { return !filter || strstr(name, filter); }
+
+        /**
+         * @brief Print a result computed outside of Run (e.g. one-shot measurements).
+         */
+        void Report(const char* name, size_t items, double minNs, double medianNs, double allocations) const
+        {
+            printf("%-44s %8zu %12.2f %12.2f %12.2f\n", name, items, minNs, medianNs, allocations);
+            fflush(stdout);
+        }
+
+        /**
+         * @brief Run a benchmark.
+         * @param name Name printed in the report.
+         * @param items Number of items processed by one sample, used to normalise the time.
+         * @param body Callable receiving a Stopwatch&, timing its own region with Start/Stop.
+         */
+        template <typename Body>
+        void Run(const char* name, size_t items, Body body)
+        {
+            if (!Enabled(name)) return;
+
+            Stopwatch warmUp;
+            body(warmUp);
+
+            double samples[MaxRepetitions];
+            size_t allocations = 0;
+
+            for (size_t i = 0; i < repetitions; i++)
+            {
+                Stopwatch stopwatch;
+                body(stopwatch);
+                samples[i] = static_cast<double>(stopwatch.Elapsed()) / (items ? items : 1);
+                allocations += stopwatch.Allocations();
+            }
+
+            qsort(samples, repetitions, sizeof(double), CompareSamples);
+            Report(name, items, samples[0], samples[repetitions / 2], static_cast<double>(allocations) / repetitions);
+        }
+    };
+}
@@ -0,0 +1,237 @@
+#include "Bench.hpp"
+#include "../Utils/HierarchicalBitset.hpp"
+
+using namespace Hyperion::Benchmark;
+
+static constexpr size_t Capacity = 65536;
+static constexpr size_t Densities[] = { 1, 50, 99 };
+
+/**
+ * @brief Run the scans of one bitset type, checking they all agree.
+ * @return true if every scan visited the same bits.
+ */
+template <typename Bitset>
+static bool RunScans(Suite& suite, const char* kind, Bitset& bitset, size_t density)
+{
+    char name[64];
+    size_t expected = 0;
+    for (size_t pos = 0; pos < Capacity; pos++)
+    {
+        expected += bitset.Get(pos) ? pos : 0;
+    }
+
+    size_t sums[3] = {};
+
+    snprintf(name, sizeof(name), "%s %zu%%/iterate Get", kind, density);
+    suite.Run(name, Capacity, [&bitset, &sums](Stopwatch& stopwatch)
+    {
+        size_t sum = 0;
+        stopwatch.Start();
+        for (size_t pos = 0; pos < Capacity; pos++)
+        {
+            if (bitset.Get(pos)) sum += pos;
+        }
+        stopwatch.Stop();
+        sums[0] = sum;
+    });
+
+    snprintf(name, sizeof(name), "%s %zu%%/iterate FindNext", kind, density);
+    suite.Run(name, Capacity, [&bitset, &sums](Stopwatch& stopwatch)
+    {
+        size_t sum = 0;
+        stopwatch.Start();
+        for (size_t pos = 0; bitset.FindNext(pos); pos++)
+        {
+            sum += pos;
+        }
+        stopwatch.Stop();
+        sums[1] = sum;
+    });
+
+    snprintf(name, sizeof(name), "%s %zu%%/iterate ForEachSet", kind, density);
+    suite.Run(name, Capacity, [&bitset, &sums](Stopwatch& stopwatch)
+    {
+        size_t sum = 0;
+        stopwatch.Start();
+        bitset.ForEachSet([&sum](size_t pos) { sum += pos; });
+        stopwatch.Stop();
+        sums[2] = sum;
+    });
+
+    snprintf(name, sizeof(name), "%s %zu%%/Count", kind, density);
+    suite.Run(name, Capacity, [&bitset](Stopwatch& stopwatch)
+    {
+        stopwatch.Start();
+        Consume(bitset.Count());
+        stopwatch.Stop();
+    });
+
+    // Filtered out scans leave their sum at 0
+    bool agree = true;
+    for (size_t i = 0; i < 3; i++)
+    {
+        agree = agree && (sums[i] == expected || sums[i] == 0);
+    }
+    return agree;
+}
+
+/**
+ * @brief Run the combine operations, against the same work done one bit at a time.
+ */
+template <typename Bitset>
+static void RunCombine(Suite& suite, const char* kind, Bitset& target, const Bitset& mask)
+{
+    char name[64];
+
+    static size_t* order = new size_t[Capacity];
+    for (size_t pos = 0; pos < Capacity; pos++)
+    {
+        order[pos] = pos;
+    }
+    Random().Shuffle(order, Capacity);
+
+    snprintf(name, sizeof(name), "%s/Set+Clear random", kind);
+    suite.Run(name, Capacity * 2, [&target](Stopwatch& stopwatch)
+    {
+        stopwatch.Start();
+        for (size_t i = 0; i < Capacity; i++) target.Set(order[i]);
+        for (size_t i = 0; i < Capacity; i++) target.Clear(order[i]);
+        stopwatch.Stop();
+    });
+
+    snprintf(name, sizeof(name), "%s/LookupSetPos random", kind);
+    suite.Run(name, Capacity / 64, [&target](Stopwatch& stopwatch)
+    {
+        size_t sum = 0;
+        stopwatch.Start();
+        for (size_t i = 0; i < Capacity / 64; i++)
+        {
+            size_t pos = 0;
+            target.Set(order[i]);
+            target.LookupSetPos(pos);
+            target.Clear(pos);
+            sum += pos;
+        }
+        stopwatch.Stop();
+        Consume(sum);
+    });
+
+    snprintf(name, sizeof(name), "%s/And per bit", kind);
+    suite.Run(name, Capacity, [&target, &mask](Stopwatch& stopwatch)
+    {
+        stopwatch.Start();
+        for (size_t pos = 0; pos < Capacity; pos++)
+        {
+            if (!mask.Get(pos)) target.Clear(pos);
+        }
+        stopwatch.Stop();
+    });
+
+    snprintf(name, sizeof(name), "%s/And", kind);
+    suite.Run(name, Capacity, [&target, &mask](Stopwatch& stopwatch)
+    {
+        stopwatch.Start();
+        target.And(mask);
+        stopwatch.Stop();
+    });
+
+    snprintf(name, sizeof(name), "%s/Or", kind);
+    suite.Run(name, Capacity, [&target, &mask](Stopwatch& stopwatch)
+    {
+        stopwatch.Start();
+        target.Or(mask);
+        stopwatch.Stop();
+    });
+
+    snprintf(name, sizeof(name), "%s/Xor", kind);
+    suite.Run(name, Capacity, [&target, &mask](Stopwatch& stopwatch)
+    {
+        stopwatch.Start();
+        target.Xor(mask);
+        stopwatch.Stop();
+    });
+
+    snprintf(name, sizeof(name), "%s/Intersects disjoint", kind);
+    suite.Run(name, Capacity, [&target, &mask](Stopwatch& stopwatch)
+    {
+        target.ClearRange(0, Capacity);
+        target.SetRange(0, Capacity);
+        target.AndNot(mask);
+        stopwatch.Start();
+        Consume(target.Intersects(mask));
+        stopwatch.Stop();
+    });
+
+    snprintf(name, sizeof(name), "%s/SetRange+ClearRange per bit", kind);
+    suite.Run(name, Capacity, [&target](Stopwatch& stopwatch)
+    {
+        stopwatch.Start();
+        for (size_t pos = 3; pos < Capacity - 3; pos++) target.Set(pos);
+        for (size_t pos = 3; pos < Capacity - 3; pos++) target.Clear(pos);
+        stopwatch.Stop();
+    });
+
+    snprintf(name, sizeof(name), "%s/SetRange+ClearRange", kind);
+    suite.Run(name, Capacity, [&target](Stopwatch& stopwatch)
+    {
+        stopwatch.Start();
+        target.SetRange(3, Capacity - 3);
+        target.ClearRange(3, Capacity - 3);
+        stopwatch.Stop();
+    });
+}
+
+int main(int argc, char** argv)
+{
+    Suite suite(argc, argv, "Hierarchical bitset");
+
+    static FixedHierarchicalBitset<Capacity> fixed;
+    HierarchicalBitset dynamic(Capacity);
+    bool agree = true;
+
+    for (size_t density : Densities)
+    {
+        Random random;
+        size_t count = 0;
+        for (size_t pos = 0; pos < Capacity; pos++)
+        {
+            if (random.Next(100) < density)
+            {
+                fixed.Set(pos);
+                dynamic.Set(pos);
+                count++;
+            }
+            else
+            {
+                fixed.Clear(pos);
+                dynamic.Clear(pos);
+            }
+        }
+
+        agree = agree && fixed.Count() == count && dynamic.Count() == count;
+        agree = RunScans(suite, "fixed", fixed, density) && agree;
+        agree = RunScans(suite, "dynamic", dynamic, density) && agree;
+    }
+
+    // Combine against a 50% mask
+    static FixedHierarchicalBitset<Capacity> fixedMask;
+    HierarchicalBitset dynamicMask(Capacity);
+    Random random;
+    for (size_t pos = 0; pos < Capacity; pos++)
+    {
+        if (random.Next(2))
+        {
+            fixedMask.Set(pos);
+            dynamicMask.Set(pos);
+        }
+    }
+    RunCombine(suite, "fixed", fixed, fixedMask);
+    RunCombine(suite, "dynamic", dynamic, dynamicMask);
+
+    if (!agree)
+    {
+        printf("scans disagree\n");
+        return 1;
+    }
+    return 0;
+}
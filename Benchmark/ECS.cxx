@@ -0,0 +1,315 @@
+#include "Bench.hpp"
+#include "../ECS/World.hpp"
+
+using namespace Hyperion::ECS;
+using namespace Hyperion::Benchmark;
+
+/**
+ * @brief Hot data component, distinct type per index.
+ */
+template <size_t N>
+struct Data
+{
+    int32_t value = 0;
+};
+
+/**
+ * @brief Small component used to fan entities out into many archetypes.
+ */
+template <size_t N>
+struct Flag
+{
+    uint8_t value = 0;
+};
+
+/**
+ * @brief Component never attached to an entity, used to force fresh query caches.
+ */
+template <size_t N>
+struct Probe
+{
+    uint8_t value = 0;
+};
+
+/**
+ * @brief System touching the first components of an entity.
+ */
+template <typename Sequence>
+struct Touch;
+
+template <size_t... Is>
+struct Touch<Sequence<Is...>>
+{
+    void operator()(Data<Is>*... data) const { ((data->value += 1), ...); }
+};
+
+static constexpr size_t EntityCounts[] = { 1000, 4000, 16000, 60000 };
+static constexpr size_t MaxEntities = 60000;
+
+static EntityReference* entities = new EntityReference[MaxEntities];
+
+static void DestroyAll(size_t count)
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        entities[i].Destroy();
+    }
+}
+
+template <size_t... Is>
+static void CreateAll(size_t count, Sequence<Is...>)
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        entities[i] = World::CreateEntity<Data<Is>...>();
+    }
+}
+
+static void CreateDestroy(Suite& suite)
+{
+    for (size_t count : EntityCounts)
+    {
+        suite.Run("create/2 components", count, [count](Stopwatch& stopwatch)
+        {
+            stopwatch.Start();
+            CreateAll(count, CreateIndexSequence<2>{});
+            stopwatch.Stop();
+            DestroyAll(count);
+        });
+
+        suite.Run("create/8 components", count, [count](Stopwatch& stopwatch)
+        {
+            stopwatch.Start();
+            CreateAll(count, CreateIndexSequence<8>{});
+            stopwatch.Stop();
+            DestroyAll(count);
+        });
+
+        suite.Run("create/lambda init 2 components", count, [count](Stopwatch& stopwatch)
+        {
+            stopwatch.Start();
+            for (size_t i = 0; i < count; i++)
+            {
+                entities[i] = World::CreateEntity([i](Data<0>* a, Data<1>* b)
+                {
+                    a->value = static_cast<int32_t>(i);
+                    b->value = 1;
+                });
+            }
+            stopwatch.Stop();
+            DestroyAll(count);
+        });
+
+        suite.Run("destroy/8 components", count, [count](Stopwatch& stopwatch)
+        {
+            CreateAll(count, CreateIndexSequence<8>{});
+            stopwatch.Start();
+            DestroyAll(count);
+            stopwatch.Stop();
+        });
+    }
+}
+
+template <size_t ComponentCount>
+static void IterateComponents(Suite& suite, size_t count)
+{
+    char name[64];
+    snprintf(name, sizeof(name), "iterate/%zu of 8 components", ComponentCount);
+    suite.Run(name, count, [](Stopwatch& stopwatch)
+    {
+        World::EntityIterator iterator;
+        stopwatch.Start();
+        iterator.Iterate(Touch<CreateIndexSequence<ComponentCount>>{});
+        stopwatch.Stop();
+    });
+}
+
+static void Iterate(Suite& suite)
+{
+    for (size_t count : EntityCounts)
+    {
+        CreateAll(count, CreateIndexSequence<8>{});
+        [&suite, count]<size_t... Is>(Sequence<Is...>)
+        {
+            (IterateComponents<Is + 1>(suite, count), ...);
+        }(CreateIndexSequence<8>{});
+        DestroyAll(count);
+    }
+}
+
+static void Migrate(Suite& suite)
+{
+    for (size_t count : EntityCounts)
+    {
+        CreateAll(count, CreateIndexSequence<4>{});
+
+        suite.Run("migrate/add 1 to 4 components", count, [count](Stopwatch& stopwatch)
+        {
+            stopwatch.Start();
+            for (size_t i = 0; i < count; i++)
+            {
+                entities[i].AddComponents<Data<4>>();
+            }
+            stopwatch.Stop();
+            for (size_t i = 0; i < count; i++)
+            {
+                entities[i].RemoveComponents<Data<4>>();
+            }
+        });
+
+        suite.Run("migrate/remove 1 from 5 components", count, [count](Stopwatch& stopwatch)
+        {
+            for (size_t i = 0; i < count; i++)
+            {
+                entities[i].AddComponents<Data<4>>();
+            }
+            stopwatch.Start();
+            for (size_t i = 0; i < count; i++)
+            {
+                entities[i].RemoveComponents<Data<4>>();
+            }
+            stopwatch.Stop();
+        });
+
+        DestroyAll(count);
+    }
+}
+
+static void Access(Suite& suite)
+{
+    for (size_t count : EntityCounts)
+    {
+        // Spread the entities over four archetypes sharing the accessed components
+        for (size_t i = 0; i < count; i++)
+        {
+            switch (i % 4)
+            {
+            case 0: entities[i] = World::CreateEntity<Data<0>, Data<1>>(); break;
+            case 1: entities[i] = World::CreateEntity<Data<0>, Data<1>, Data<2>>(); break;
+            case 2: entities[i] = World::CreateEntity<Data<0>, Data<1>, Flag<0>>(); break;
+            default: entities[i] = World::CreateEntity<Data<0>, Data<1>, Data<2>, Flag<1>>(); break;
+            }
+        }
+
+        EntityReference* shuffled = new EntityReference[count];
+        for (size_t i = 0; i < count; i++)
+        {
+            shuffled[i] = entities[i];
+        }
+        Random().Shuffle(shuffled, count);
+
+        suite.Run("access/sequential", count, [count](Stopwatch& stopwatch)
+        {
+            stopwatch.Start();
+            for (size_t i = 0; i < count; i++)
+            {
+                entities[i].Access([](Data<0>* a, Data<1>* b) { a->value += b->value; });
+            }
+            stopwatch.Stop();
+        });
+
+        suite.Run("access/random", count, [count, shuffled](Stopwatch& stopwatch)
+        {
+            stopwatch.Start();
+            for (size_t i = 0; i < count; i++)
+            {
+                shuffled[i].Access([](Data<0>* a, Data<1>* b) { a->value += b->value; });
+            }
+            stopwatch.Stop();
+        });
+
+        suite.Run("access/batched sequential", count, [count](Stopwatch& stopwatch)
+        {
+            stopwatch.Start();
+            World::AccessBatch(entities, count, [](Data<0>* a, Data<1>* b) { a->value += b->value; });
+            stopwatch.Stop();
+        });
+
+        suite.Run("access/batched random", count, [count, shuffled](Stopwatch& stopwatch)
+        {
+            stopwatch.Start();
+            World::AccessBatch(shuffled, count, [](Data<0>* a, Data<1>* b) { a->value += b->value; });
+            stopwatch.Stop();
+        });
+
+        delete[] shuffled;
+        DestroyAll(count);
+    }
+}
+
+/**
+ * @brief Add the flag components selected by a bit mask, one migration per flag.
+ */
+template <size_t... Is>
+static void AddFlags(EntityReference& entity, size_t mask, Sequence<Is...>)
+{
+    ((mask & (1 << Is) ? entity.AddComponents<Flag<Is>>() : false), ...);
+}
+
+/**
+ * @brief Run fresh queries, each one scanning every archetype once to fill its cache.
+ */
+template <size_t First, size_t... Is>
+static uint64_t ColdQueries(Sequence<Is...>)
+{
+    Stopwatch stopwatch;
+    stopwatch.Start();
+    (World::EntityIterator().Iterate([](Data<0>*, Probe<First + Is>*) {}), ...);
+    stopwatch.Stop();
+    return stopwatch.Elapsed();
+}
+
+static void QueryCache(Suite& suite)
+{
+    // Archetypes accumulate for the lifetime of the world, so this runs last and grows in stages
+    static constexpr size_t ProbesPerStage = 4;
+    static constexpr size_t FlagCounts[] = { 4, 6, 8 };
+    size_t created = 0;
+
+    for (size_t stage = 0; stage < 3; stage++)
+    {
+        const size_t archetypes = size_t(1) << FlagCounts[stage];
+        for (size_t mask = created; mask < archetypes; mask++)
+        {
+            entities[mask] = World::CreateEntity<Data<0>>();
+            AddFlags(entities[mask], mask, CreateIndexSequence<8>{});
+        }
+        created = archetypes;
+
+        const size_t managerCount = World::ArchetypeCount();
+        uint64_t elapsed = 0;
+        switch (stage)
+        {
+        case 0: elapsed = ColdQueries<0>(CreateIndexSequence<ProbesPerStage>{}); break;
+        case 1: elapsed = ColdQueries<ProbesPerStage>(CreateIndexSequence<ProbesPerStage>{}); break;
+        default: elapsed = ColdQueries<ProbesPerStage * 2>(CreateIndexSequence<ProbesPerStage>{}); break;
+        }
+
+        if (suite.Enabled("query-cache/cold update per archetype"))
+        {
+            const double perArchetype = static_cast<double>(elapsed) / (ProbesPerStage * managerCount);
+            suite.Report("query-cache/cold update per archetype", managerCount, perArchetype, perArchetype, 0);
+        }
+
+        suite.Run("query-cache/warm 1 entity per archetype", archetypes, [](Stopwatch& stopwatch)
+        {
+            World::EntityIterator iterator;
+            stopwatch.Start();
+            iterator.Iterate(Touch<CreateIndexSequence<1>>{});
+            stopwatch.Stop();
+        });
+    }
+
+    DestroyAll(created);
+}
+
+int main(int argc, char** argv)
+{
+    Suite suite(argc, argv, "ECS");
+    CreateDestroy(suite);
+    Iterate(suite);
+    Migrate(suite);
+    Access(suite);
+    QueryCache(suite);
+    return 0;
+}
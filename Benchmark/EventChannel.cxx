@@ -0,0 +1,141 @@
+#include <pthread.h>
+#include <sched.h>
+
+#include "Bench.hpp"
+#include "../Utils/EventManager.hpp"
+
+using namespace Hyperion::Benchmark;
+
+/**
+ * @brief Event numbered by its sender, each CPU checks it receives them all in order.
+ */
+struct Sequence
+{
+    uint32_t value;
+    uint32_t padding[3];
+};
+
+static constexpr uint32_t EventCount = 1 << 16;
+
+static thread_local uint32_t received = 0;
+static bool outOfOrder = false;
+
+static void OnSequence(Sequence* event)
+{
+    if (event->value != received)
+    {
+        __atomic_store_n(&outOfOrder, true, __ATOMIC_RELAXED);
+    }
+    received++;
+}
+
+/**
+ * @brief Give the other thread a chance to run, the host may have fewer cores than threads.
+ */
+static void Wait()
+{
+    sched_yield();
+}
+
+/**
+ * @brief Send EventCount numbered events to the other CPU, optionally draining the events it sends back.
+ */
+static void Stream(CPUType target, bool drain)
+{
+    for (uint32_t value = 0; value < EventCount;)
+    {
+        if (EventManager::QueueEvent(Sequence{ value, {} }, target))
+        {
+            value++;
+        }
+        else if (!drain || !EventManager::ProcessChannelEvents())
+        {
+            Wait();
+        }
+    }
+
+    while (drain && received < EventCount)
+    {
+        if (!EventManager::ProcessChannelEvents()) Wait();
+    }
+}
+
+/**
+ * @brief Work of the slave CPU, run on its own thread.
+ */
+static void* SlaveThread(void* duplex)
+{
+    hostCPU = CPUType::Slave;
+    received = 0;
+    Stream(CPUType::Master, duplex != nullptr);
+    return nullptr;
+}
+
+/**
+ * @brief Run the slave thread against the master one, checking every event arrives once and in order.
+ * @return false if events were lost, duplicated or reordered.
+ */
+static bool Run(Suite& suite, const char* name, bool duplex)
+{
+    bool delivered = true;
+    const size_t events = duplex ? EventCount * 2 : EventCount;
+    suite.Run(name, events, [duplex, &delivered](Stopwatch& stopwatch)
+    {
+        pthread_t slave;
+        received = 0;
+
+        stopwatch.Start();
+        pthread_create(&slave, nullptr, SlaveThread, duplex ? &slave : nullptr);
+        if (duplex)
+        {
+            Stream(CPUType::Slave, true);
+        }
+        while (received < EventCount)
+        {
+            if (!EventManager::ProcessChannelEvents()) Wait();
+        }
+        pthread_join(slave, nullptr);
+        stopwatch.Stop();
+
+        delivered = delivered && received == EventCount && EventManager::ProcessChannelEvents() == 0;
+    });
+    return delivered;
+}
+
+int main(int argc, char** argv)
+{
+    Suite suite(argc, argv, "Cross-CPU event channel");
+
+    EventManager::AddListener<Sequence>(&OnSequence);
+
+    bool delivered = true;
+
+    suite.Run("same CPU/push+drain 32", EventCount, [](Stopwatch& stopwatch)
+    {
+        received = 0;
+        hostCPU = CPUType::Slave;
+        stopwatch.Start();
+        for (uint32_t value = 0; value < EventCount; value++)
+        {
+            EventManager::QueueEvent(Sequence{ value, {} }, CPUType::Master);
+            if ((value & 31) == 31)
+            {
+                hostCPU = CPUType::Master;
+                EventManager::ProcessChannelEvents();
+                hostCPU = CPUType::Slave;
+            }
+        }
+        stopwatch.Stop();
+        hostCPU = CPUType::Master;
+    });
+
+    delivered = Run(suite, "slave to master", false) && delivered;
+    delivered = Run(suite, "both ways", true) && delivered;
+
+    if (!delivered || outOfOrder)
+    {
+        printf("events lost or out of order\n");
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,172 @@
+#include "Bench.hpp"
+#include "../Utils/EventManager.hpp"
+
+using namespace Hyperion::Benchmark;
+
+/**
+ * @brief Collision between two entities, queued by the physics step.
+ * @tparam Batched Whether it is delivered to a batch listener, each variant is its own event type.
+ */
+template <bool Batched>
+struct Collision
+{
+    uint16_t first, second;
+    int32_t impulse;
+};
+
+/**
+ * @brief Damage dealt to an entity, queued by gameplay code.
+ * @tparam Batched Whether it is delivered to a batch listener, each variant is its own event type.
+ */
+template <bool Batched>
+struct Damage
+{
+    uint16_t target;
+    int16_t amount;
+};
+
+static constexpr size_t EventCounts[] = { 64, 256, 1024 };
+
+static int64_t impulses = 0;
+static int64_t damages = 0;
+
+static void OnCollision(Collision<false>* collision)
+{
+    impulses += collision->impulse;
+}
+
+static void OnCollisions(const Collision<true>* collisions, size_t count)
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        impulses += collisions[i].impulse;
+    }
+}
+
+static void OnDamage(Damage<false>* damage)
+{
+    damages += damage->amount;
+}
+
+static void OnDamages(const Damage<true>* events, size_t count)
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        damages += events[i].amount;
+    }
+}
+
+/**
+ * @brief Effect subscribing to a gameplay event for a while, many come and go each frame.
+ */
+struct Tick
+{
+    uint32_t frame;
+};
+
+static constexpr size_t Subscribers = 64;
+
+static uint8_t lastPriority = 0;
+static bool ordered = true;
+
+template <uint8_t Priority>
+static void OnTick(Tick* tick)
+{
+    ordered = ordered && lastPriority <= Priority;
+    lastPriority = Priority;
+}
+
+static constexpr EventManager::EventListener<Tick> TickListeners[] = { &OnTick<0>, &OnTick<1>, &OnTick<2>, &OnTick<3>, &OnTick<4> };
+
+/**
+ * @brief Queue a frame of interleaved collision and damage events, then dispatch them.
+ * @return true if every event was queued and delivered once.
+ */
+template <bool Batched>
+static bool Frame(size_t count)
+{
+    int64_t expectedImpulses = impulses;
+    int64_t expectedDamages = damages;
+    bool queued = true;
+    for (size_t i = 0; i < count; i++)
+    {
+        const Collision<Batched> collision = { static_cast<uint16_t>(i), static_cast<uint16_t>(i + 1), static_cast<int32_t>(i) };
+        const Damage<Batched> damage = { static_cast<uint16_t>(i), static_cast<int16_t>(i & 0xFF) };
+        queued = EventManager::QueueEvent(collision) && queued;
+        queued = EventManager::QueueEvent(damage) && queued;
+        expectedImpulses += collision.impulse;
+        expectedDamages += damage.amount;
+    }
+
+    EventManager::ProcessQueuedEvents();
+    return queued && impulses == expectedImpulses && damages == expectedDamages;
+}
+
+int main(int argc, char** argv)
+{
+    Suite suite(argc, argv, "Event queues");
+
+    EventManager::AddListener<Collision<false>>(&OnCollision);
+    EventManager::AddListener<Collision<true>>(&OnCollisions);
+    EventManager::AddListener<Damage<false>>(&OnDamage);
+    EventManager::AddListener<Damage<true>>(&OnDamages);
+
+    bool delivered = true;
+    for (size_t count : EventCounts)
+    {
+        char name[64];
+
+        snprintf(name, sizeof(name), "queue+dispatch/per event %zu", count);
+        suite.Run(name, count * 2, [count, &delivered](Stopwatch& stopwatch)
+        {
+            stopwatch.Start();
+            delivered = Frame<false>(count) && delivered;
+            stopwatch.Stop();
+        });
+
+        snprintf(name, sizeof(name), "queue+dispatch/batch %zu", count);
+        suite.Run(name, count * 2, [count, &delivered](Stopwatch& stopwatch)
+        {
+            stopwatch.Start();
+            delivered = Frame<true>(count) && delivered;
+            stopwatch.Stop();
+        });
+    }
+
+    suite.Run("listeners/add+remove 64", Subscribers * 2, [](Stopwatch& stopwatch)
+    {
+        static EventManager::ListenerHandle handles[Subscribers];
+        static size_t order[Subscribers];
+        Random random;
+        for (size_t i = 0; i < Subscribers; i++)
+        {
+            order[i] = i;
+        }
+        random.Shuffle(order, Subscribers);
+
+        stopwatch.Start();
+        for (size_t i = 0; i < Subscribers; i++)
+        {
+            const size_t priority = i % 5;
+            handles[i] = EventManager::AddListener<Tick>(TickListeners[priority], static_cast<EventManager::ListenerPriority>(priority));
+        }
+        stopwatch.Stop();
+
+        lastPriority = 0;
+        EventManager::TriggerEvent(Tick{ 0 });
+
+        stopwatch.Start();
+        for (size_t i = 0; i < Subscribers; i++)
+        {
+            EventManager::RemoveListener(handles[order[i]]);
+        }
+        stopwatch.Stop();
+    });
+
+    if (!delivered || !ordered)
+    {
+        printf("events lost or listeners out of order\n");
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,108 @@
+#include "Bench.hpp"
+#include "../Utils/FrameArena.hpp"
+
+using namespace Hyperion::Benchmark;
+
+static constexpr size_t PerFrame = 256;
+static constexpr size_t Frames = 16;
+static constexpr size_t MaxSize = 256;
+
+static size_t sizes[Frames][PerFrame];
+
+/**
+ * @brief Transient allocations of a frame: fill each one, as temp lists and command buffers would be.
+ */
+template <typename Allocate>
+static void Frame(size_t frame, char** blocks, Allocate allocate)
+{
+    for (size_t i = 0; i < PerFrame; i++)
+    {
+        blocks[i] = (char*)allocate(sizes[frame][i]);
+        memset(blocks[i], static_cast<int>(frame), sizes[frame][i]);
+    }
+}
+
+/**
+ * @brief Check the blocks of a frame still hold what it wrote, and are aligned.
+ */
+static bool Intact(size_t frame, char* const* blocks)
+{
+    for (size_t i = 0; i < PerFrame; i++)
+    {
+        if (!blocks[i] || reinterpret_cast<uintptr_t>(blocks[i]) % alignof(max_align_t))
+            return false;
+
+        for (size_t byte = 0; byte < sizes[frame][i]; byte++)
+        {
+            if (blocks[i][byte] != static_cast<char>(frame))
+                return false;
+        }
+    }
+    return true;
+}
+
+int main(int argc, char** argv)
+{
+    Suite suite(argc, argv, "Frame arena (per allocation)");
+
+    Random random;
+    for (size_t frame = 0; frame < Frames; frame++)
+    {
+        for (size_t i = 0; i < PerFrame; i++)
+        {
+            sizes[frame][i] = 16 + random.Next(MaxSize);
+        }
+    }
+
+    static char* blocks[2][PerFrame];
+
+    suite.Run("lwram::malloc+free", Frames * PerFrame, [](Stopwatch& stopwatch)
+    {
+        stopwatch.Start();
+        for (size_t frame = 0; frame < Frames; frame++)
+        {
+            char** previous = blocks[(frame + 1) & 1];
+            if (frame)
+            {
+                for (size_t i = 0; i < PerFrame; i++) lwram::free(previous[i]);
+            }
+            Frame(frame, blocks[frame & 1], [](size_t size) { return lwram::malloc(size); });
+        }
+        for (size_t i = 0; i < PerFrame; i++) lwram::free(blocks[(Frames - 1) & 1][i]);
+        stopwatch.Stop();
+    });
+
+    FrameArena<MemoryRegion::LWRAM> arena(PerFrame * (MaxSize + 16 + alignof(max_align_t)));
+    bool intact = arena.Capacity() != 0;
+
+    suite.Run("frame arena", Frames * PerFrame, [&arena, &intact](Stopwatch& stopwatch)
+    {
+        for (size_t frame = 0; frame < Frames; frame++)
+        {
+            stopwatch.Start();
+            Frame(frame, blocks[frame & 1], [&arena](size_t size) { return arena.Allocate(size); });
+            arena.EndFrame();
+            stopwatch.Stop();
+
+            // Data of the frame just ended lives through the next one
+            intact = intact && Intact(frame, blocks[frame & 1]);
+            if (frame)
+            {
+                intact = intact && Intact(frame - 1, blocks[(frame + 1) & 1]);
+            }
+        }
+    });
+
+    if (suite.Enabled("frame arena"))
+    {
+        printf("%-44s %zu of %zu bytes, %zu failed\n", "frame arena/high water", arena.HighWater(), arena.Capacity(), arena.Failed());
+        intact = intact && arena.Failed() == 0;
+    }
+
+    if (!intact)
+    {
+        printf("frame arena data overwritten\n");
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,154 @@
+#include "Bench.hpp"
+#include "../ECS/FrustumCulling.hpp"
+
+using namespace Hyperion::ECS;
+using namespace Hyperion::Benchmark;
+
+static constexpr size_t ParentCount = 1000;
+static constexpr size_t ChildrenPerParent = 8;
+static constexpr size_t EntityCount = ParentCount * (ChildrenPerParent + 1);
+static constexpr size_t FrameCount = 64;
+
+static EntityReference* entities = new EntityReference[EntityCount];
+
+static Fxp RandomCoordinate(Random& random, int16_t halfExtent)
+{
+    return Fxp::BuildRaw(static_cast<int32_t>(random.Next(static_cast<uint32_t>(halfExtent) << 17)) - (halfExtent << 16));
+}
+
+/**
+ * @brief Camera turning around the vertical axis at the origin, 1/256 of a turn per frame.
+ */
+static void UpdateCamera(Frustum& frustum, size_t frame)
+{
+    const Fxp angle = Fxp::BuildRaw(static_cast<int32_t>((frame << 16) / 256));
+    frustum.Update(Vec3(), Vec3(Trigonometry::Sin(angle), 0.0, Trigonometry::Cos(angle)));
+}
+
+/**
+ * @brief Create parents scattered in a 256 x 32 x 256 box, each with children inside its bounding sphere.
+ * @param linked Whether children reference their parent, otherwise every entity is culled on its own.
+ */
+static void CreateScene(bool linked)
+{
+    Random random(42);
+    size_t count = 0;
+    for (size_t i = 0; i < ParentCount; i++)
+    {
+        const Vec3 center(RandomCoordinate(random, 128), RandomCoordinate(random, 16), RandomCoordinate(random, 128));
+        const EntityReference parent = World::CreateEntity([&center](BoundingSphere* sphere, CullingState* state)
+        {
+            sphere->center = center;
+            sphere->radius = 6.0;
+        });
+        entities[count++] = parent;
+
+        for (size_t j = 0; j < ChildrenPerParent; j++)
+        {
+            const Vec3 offset(RandomCoordinate(random, 3), RandomCoordinate(random, 3), RandomCoordinate(random, 3));
+            entities[count++] = World::CreateEntity([&](BoundingSphere* sphere, CullingState* state)
+            {
+                sphere->center = center + offset;
+                sphere->radius = 1.0;
+                if (linked) state->parent = parent;
+            });
+        }
+    }
+}
+
+static void DestroyScene()
+{
+    for (size_t i = 0; i < EntityCount; i++)
+    {
+        entities[i].Destroy();
+    }
+}
+
+/**
+ * @brief Print the average number of plane tests per object and frame next to the timings.
+ */
+static void ReportPlanes(const Suite& suite, const char* name, size_t planeTests)
+{
+    if (suite.Enabled(name))
+    {
+        printf("%-44s %8zu %12.2f planes/object\n", name, EntityCount, static_cast<double>(planeTests) / (EntityCount * FrameCount));
+    }
+}
+
+/**
+ * @brief Reference: Frustum::SphereInFrustum on every entity, all planes until one rejects it.
+ */
+static void BenchmarkBruteForce(Suite& suite, const char* name)
+{
+    suite.Run(name, EntityCount * FrameCount, [](Stopwatch& stopwatch)
+    {
+        Frustum frustum(0.125, 4.0 / 3.0, 1.0, 96.0);
+        World::EntityIterator iterator;
+        size_t visible = 0;
+        for (size_t frame = 0; frame < FrameCount; frame++)
+        {
+            UpdateCamera(frustum, frame);
+            stopwatch.Start();
+            iterator.Iterate([&frustum, &visible](BoundingSphere* sphere)
+            {
+                visible += frustum.SphereInFrustum(sphere->center, sphere->radius * Fxp(2.0));
+            });
+            stopwatch.Stop();
+        }
+        Consume(visible);
+    });
+
+    // Count the planes SphereInFrustum goes through
+    Frustum frustum(0.125, 4.0 / 3.0, 1.0, 96.0);
+    World::EntityIterator iterator;
+    size_t planeTests = 0;
+    for (size_t frame = 0; frame < FrameCount; frame++)
+    {
+        UpdateCamera(frustum, frame);
+        iterator.Iterate([&frustum, &planeTests](BoundingSphere* sphere)
+        {
+            for (size_t i = 0; i < Frustum::PlaneCount; i++)
+            {
+                planeTests++;
+                if (frustum.GetPlane(i).Distance(sphere->center) < -sphere->radius) break;
+            }
+        });
+    }
+    ReportPlanes(suite, name, planeTests);
+}
+
+static void BenchmarkCulling(Suite& suite, const char* name)
+{
+    size_t planeTests = 0;
+    suite.Run(name, EntityCount * FrameCount, [&planeTests](Stopwatch& stopwatch)
+    {
+        Frustum frustum(0.125, 4.0 / 3.0, 1.0, 96.0);
+        FrustumCulling culling;
+        planeTests = 0;
+        for (size_t frame = 0; frame < FrameCount; frame++)
+        {
+            UpdateCamera(frustum, frame);
+            stopwatch.Start();
+            culling.Cull(frustum);
+            stopwatch.Stop();
+            planeTests += culling.PlaneTests();
+        }
+    });
+    ReportPlanes(suite, name, planeTests);
+}
+
+int main(int argc, char** argv)
+{
+    Suite suite(argc, argv, "Frustum culling (turning camera, per object and frame)");
+
+    CreateScene(false);
+    BenchmarkBruteForce(suite, "SphereInFrustum/flat");
+    BenchmarkCulling(suite, "FrustumCulling/flat");
+    DestroyScene();
+
+    CreateScene(true);
+    BenchmarkCulling(suite, "FrustumCulling/hierarchy");
+    DestroyScene();
+
+    return 0;
+}
@@ -0,0 +1,136 @@
+#include "Bench.hpp"
+#include "../ECS/World.hpp"
+
+using namespace Hyperion::ECS;
+using namespace Hyperion::Benchmark;
+
+struct Position
+{
+    int32_t x = 0, y = 0, z = 0;
+};
+
+struct Velocity
+{
+    int32_t x = 1, y = 1, z = 1;
+};
+
+struct Collider
+{
+    int32_t radius = 8;
+};
+
+/**
+ * @brief Cold component splitting the physics entities into many archetypes.
+ */
+template <size_t N>
+struct Cold
+{
+    int32_t value[4] = {};
+};
+
+static constexpr size_t ArchetypeCount = 12;
+static constexpr size_t EntityCount = 4000;
+
+static EntityReference* entities = new EntityReference[EntityCount];
+
+template <size_t... Is>
+static EntityReference CreateIn(size_t archetype, Sequence<Is...>)
+{
+    EntityReference entity;
+    ((archetype == Is ? (entity = World::CreateEntity<Position, Velocity, Collider, Cold<Is>>(), true) : false) || ...);
+    return entity;
+}
+
+static void CreateAll()
+{
+    Random random;
+    for (size_t i = 0; i < EntityCount; i++)
+    {
+        entities[i] = CreateIn(random.Next(ArchetypeCount), CreateIndexSequence<ArchetypeCount>{});
+    }
+}
+
+static void DestroyAll()
+{
+    for (size_t i = 0; i < EntityCount; i++)
+    {
+        entities[i].Destroy();
+    }
+}
+
+static void Step(Position* position, Velocity* velocity, Collider* collider)
+{
+    position->x += velocity->x;
+    position->y += velocity->y;
+    position->z += velocity->z + collider->radius;
+}
+
+static void Join(Suite& suite, const char* label)
+{
+    char name[64];
+    snprintf(name, sizeof(name), "join/Iterate %s", label);
+    suite.Run(name, EntityCount, [](Stopwatch& stopwatch)
+    {
+        World::EntityIterator iterator;
+        stopwatch.Start();
+        iterator.Iterate([](Position* position, Velocity* velocity, Collider* collider) { Step(position, velocity, collider); });
+        stopwatch.Stop();
+    });
+}
+
+int main(int argc, char** argv)
+{
+    Suite suite(argc, argv, "Owning groups");
+    using Physics = OwningGroup<Position, Velocity, Collider>;
+
+    suite.Run("create+destroy/no group", EntityCount, [](Stopwatch& stopwatch)
+    {
+        stopwatch.Start();
+        CreateAll();
+        DestroyAll();
+        stopwatch.Stop();
+    });
+
+    CreateAll();
+    Join(suite, "(no group)");
+
+    Physics::Create();
+    Join(suite, "(grouped)");
+
+    suite.Run("join/group Each", EntityCount, [](Stopwatch& stopwatch)
+    {
+        stopwatch.Start();
+        Physics::Each([](Position* position, Velocity* velocity, Collider* collider) { Step(position, velocity, collider); });
+        stopwatch.Stop();
+    });
+
+    suite.Run("join/group EachSpan", EntityCount, [](Stopwatch& stopwatch)
+    {
+        stopwatch.Start();
+        Physics::EachSpan([](size_t count, Position* position, Velocity* velocity, Collider* collider)
+        {
+            for (size_t i = 0; i < count; i++)
+            {
+                Step(&position[i], &velocity[i], &collider[i]);
+            }
+        });
+        stopwatch.Stop();
+    });
+
+    DestroyAll();
+
+    suite.Run("create+destroy/grouped", EntityCount, [](Stopwatch& stopwatch)
+    {
+        stopwatch.Start();
+        CreateAll();
+        DestroyAll();
+        stopwatch.Stop();
+    });
+
+    CreateAll();
+    int64_t sum = 0;
+    Physics::Each([&sum](Position* position) { sum += position->x; });
+    printf("%-44s %8zu entities, checksum %lld\n", "group", Physics::Size(), static_cast<long long>(sum));
+
+    return 0;
+}
@@ -0,0 +1,144 @@
+#include "Bench.hpp"
+#include "../ECS/World.hpp"
+
+using namespace Hyperion::ECS;
+using namespace Hyperion::Benchmark;
+
+struct Position
+{
+    int32_t x = 0, y = 0, z = 0;
+};
+
+struct Velocity
+{
+    int32_t x = 0, y = 0, z = 0;
+};
+
+/**
+ * @brief Component carrying hooks, the kind that owns an external handle (sprite slot, sound voice...).
+ */
+struct Handle
+{
+    int32_t slot = 0;
+};
+
+/**
+ * @brief Component without hooks, created and destroyed in the baseline runs.
+ */
+struct Plain
+{
+    int32_t slot = 0;
+};
+
+static constexpr size_t EntityCount = 4000;
+
+static EntityReference* entities = new EntityReference[EntityCount];
+static size_t* order = new size_t[EntityCount];
+static int32_t nextSlot = 1;
+static size_t hookCalls = 0;
+static size_t added = 0;
+static size_t removed = 0;
+
+static void OnHandleAdded(const ComponentSpan<Handle>& span)
+{
+    hookCalls++;
+    added += span.count;
+    for (size_t i = 0; i < span.count; i++)
+    {
+        span[i].slot = nextSlot++;
+    }
+}
+
+static void OnHandleRemoved(const ComponentSpan<Handle>& span)
+{
+    // Entities destroyed before their addition was flushed never got a slot
+    hookCalls++;
+    for (size_t i = 0; i < span.count; i++)
+    {
+        removed += (span[i].slot != 0);
+    }
+}
+
+template <typename T>
+static void Create()
+{
+    for (size_t i = 0; i < EntityCount; i++)
+    {
+        entities[i] = (i & 1) ?
+            World::CreateEntity<Position, Velocity, T>() :
+            World::CreateEntity<Position, T>();
+    }
+}
+
+static void Destroy()
+{
+    for (size_t i = 0; i < EntityCount; i++)
+    {
+        entities[order[i]].Destroy();
+    }
+}
+
+int main(int argc, char** argv)
+{
+    Suite suite(argc, argv, "Component hooks");
+
+    for (size_t i = 0; i < EntityCount; i++)
+    {
+        order[i] = i;
+    }
+    Random().Shuffle(order, EntityCount);
+
+    World::OnAdd<Handle>(&OnHandleAdded);
+    World::OnRemove<Handle>(&OnHandleRemoved);
+
+    suite.Run("create+destroy/no hooks", EntityCount, [](Stopwatch& stopwatch)
+    {
+        stopwatch.Start();
+        Create<Plain>();
+        Destroy();
+        stopwatch.Stop();
+    });
+
+    suite.Run("create+destroy/hooked, recording", EntityCount, [](Stopwatch& stopwatch)
+    {
+        stopwatch.Start();
+        Create<Handle>();
+        Destroy();
+        stopwatch.Stop();
+        World::FlushHooks();
+    });
+
+    suite.Run("create+destroy/hooked, with flushes", EntityCount, [](Stopwatch& stopwatch)
+    {
+        stopwatch.Start();
+        Create<Handle>();
+        World::FlushHooks();
+        Destroy();
+        World::FlushHooks();
+        stopwatch.Stop();
+    });
+
+    suite.Run("flush adds", EntityCount, [](Stopwatch& stopwatch)
+    {
+        Create<Handle>();
+        stopwatch.Start();
+        World::FlushHooks();
+        stopwatch.Stop();
+        Destroy();
+        World::FlushHooks();
+    });
+
+    suite.Run("flush removes", EntityCount, [](Stopwatch& stopwatch)
+    {
+        Create<Handle>();
+        World::FlushHooks();
+        Destroy();
+        stopwatch.Start();
+        World::FlushHooks();
+        stopwatch.Stop();
+    });
+
+    printf("%-44s %8zu hook calls, %zu slots assigned, %zu released\n", "total", hookCalls, added, removed);
+
+    return 0;
+}
@@ -0,0 +1,65 @@
+#include "Bench.hpp"
+#include "../Utils/IdTracker.hpp"
+
+using namespace Hyperion::Benchmark;
+
+static constexpr size_t Capacity = 4096;
+static constexpr size_t Live = 2048;
+static constexpr size_t PerFrame = 256;
+static constexpr size_t Frames = 16;
+
+/**
+ * @brief Simulate frames of particles: free a random batch of live IDs, then assign as many.
+ * @tparam Tracker The tracker type.
+ * @tparam Batched Whether to use the batch calls or one call per ID.
+ */
+template <typename Tracker, bool Batched>
+static void RunFrames(Suite& suite, const char* name)
+{
+    suite.Run(name, Frames * PerFrame * 2, [](Stopwatch& stopwatch)
+    {
+        Tracker tracker(Capacity);
+        static size_t live[Live];
+        tracker.AssignIds(Live, live);
+
+        Random random;
+        stopwatch.Start();
+        for (size_t frame = 0; frame < Frames; frame++)
+        {
+            // Swap the freed IDs to the end of the live array, the new ones replace them
+            for (size_t i = 0; i < PerFrame; i++)
+            {
+                const size_t j = random.Next(static_cast<uint32_t>(Live - i));
+                const size_t id = live[j];
+                live[j] = live[Live - 1 - i];
+                live[Live - 1 - i] = id;
+            }
+
+            size_t* const slots = live + (Live - PerFrame);
+            if constexpr (Batched)
+            {
+                tracker.FreeIds(slots, PerFrame);
+                tracker.AssignIds(PerFrame, slots);
+            }
+            else
+            {
+                for (size_t i = 0; i < PerFrame; i++) tracker.FreeId(slots[i]);
+                for (size_t i = 0; i < PerFrame; i++) tracker.AssingId(slots[i]);
+            }
+        }
+        stopwatch.Stop();
+        Consume(live[0]);
+    });
+}
+
+int main(int argc, char** argv)
+{
+    Suite suite(argc, argv, "ID tracker");
+
+    RunFrames<IdTracker, false>(suite, "lowest/one at a time");
+    RunFrames<IdTracker, true>(suite, "lowest/batch");
+    RunFrames<BasicIdTracker<IdReuse::MostRecent>, false>(suite, "most recent/one at a time");
+    RunFrames<BasicIdTracker<IdReuse::MostRecent>, true>(suite, "most recent/batch");
+
+    return 0;
+}
@@ -0,0 +1,112 @@
+#include "Bench.hpp"
+#include "../ECS/World.hpp"
+
+using namespace Hyperion::ECS;
+using namespace Hyperion::Benchmark;
+
+/**
+ * @brief Position stored as a whole struct.
+ */
+struct Position
+{
+    int32_t x = 0, y = 0, z = 0;
+};
+
+/**
+ * @brief Same data as Position, stored field by field.
+ */
+struct SplitPosition
+{
+    int32_t x = 0, y = 0, z = 0;
+};
+
+template <>
+struct Hyperion::ECS::SplitLayout<SplitPosition> : Fields<&SplitPosition::x, &SplitPosition::y, &SplitPosition::z> {};
+
+// Both layouts are alive at once, so stay below the 16-bit record index limit
+static constexpr size_t EntityCounts[] = { 1000, 10000, 30000 };
+static constexpr size_t MaxEntities = 30000;
+
+static EntityReference* packed = new EntityReference[MaxEntities];
+static EntityReference* split = new EntityReference[MaxEntities];
+
+/**
+ * @brief Run one system and label it with the number of bytes it streams per entity.
+ */
+template <typename Lambda>
+static void RunSystem(Suite& suite, const char* system, size_t bytesPerEntity, size_t count, Lambda lambda)
+{
+    char name[64];
+    snprintf(name, sizeof(name), "%s (%zu B/entity)", system, bytesPerEntity);
+    suite.Run(name, count, [lambda](Stopwatch& stopwatch)
+    {
+        World::EntityIterator iterator;
+        stopwatch.Start();
+        iterator.Iterate(lambda);
+        stopwatch.Stop();
+    });
+}
+
+int main(int argc, char** argv)
+{
+    Suite suite(argc, argv, "Component layout");
+
+    for (size_t count : EntityCounts)
+    {
+        for (size_t i = 0; i < count; i++)
+        {
+            const int32_t value = static_cast<int32_t>(i);
+            packed[i] = World::CreateEntity([value](Position* position) { position->x = value; });
+            split[i] = World::CreateEntity([value](SplitPosition* position) { position->x = value; });
+        }
+
+        // Bytes per entity count the cache lines streamed in: the whole struct for packed
+        // columns, only the requested field arrays for split ones
+        RunSystem(suite, "x only/whole struct", sizeof(Position), count, [](Position* position)
+        {
+            position->x += 1;
+        });
+
+        RunSystem(suite, "x only/split field", sizeof(int32_t), count, [](Field<&SplitPosition::x>* x)
+        {
+            x->value += 1;
+        });
+
+        RunSystem(suite, "x, y, z/whole struct", sizeof(Position), count, [](Position* position)
+        {
+            position->x += position->z;
+            position->y += position->z;
+        });
+
+        RunSystem(suite, "x, y, z/split fields", 3 * sizeof(int32_t), count,
+            [](Field<&SplitPosition::x>* x, Field<&SplitPosition::y>* y, Field<&SplitPosition::z>* z)
+        {
+            x->value += z->value;
+            y->value += z->value;
+        });
+
+        RunSystem(suite, "x, y, z/split gathered struct", 3 * sizeof(int32_t), count, [](SplitPosition* position)
+        {
+            position->x += position->z;
+            position->y += position->z;
+        });
+
+        suite.Run("access/split gathered struct", count, [count](Stopwatch& stopwatch)
+        {
+            stopwatch.Start();
+            for (size_t i = 0; i < count; i++)
+            {
+                split[i].Access([](SplitPosition* position) { position->y += position->x; });
+            }
+            stopwatch.Stop();
+        });
+
+        for (size_t i = 0; i < count; i++)
+        {
+            packed[i].Destroy();
+            split[i].Destroy();
+        }
+    }
+
+    return 0;
+}
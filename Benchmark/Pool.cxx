@@ -0,0 +1,163 @@
+#include <malloc.h>
+
+#include "Bench.hpp"
+#include "../Utils/RBTree.hpp"
+#include "../Utils/std/string.h"
+
+using namespace Hyperion::Benchmark;
+
+static constexpr size_t Count = 8192;
+static constexpr size_t ObjectSize = 24;
+
+using Pool = BlockPool<ObjectSize, MemoryRegion::LWRAM>;
+using NodePool = PoolAllocator<MemoryRegion::LWRAM>;
+
+/**
+ * @brief Heap bytes the system allocator holds once its free top is trimmed, free holes between its blocks included.
+ */
+static size_t HeapInUse()
+{
+    malloc_trim(0);
+    const struct mallinfo2 info = mallinfo2();
+    return info.arena - info.keepcost;
+}
+
+/**
+ * @brief Allocate Count small objects, then free them in random order.
+ */
+template <typename Allocate, typename Free>
+static void RunChurn(Suite& suite, const char* name, Allocate allocate, Free free)
+{
+    static size_t order[Count];
+    for (size_t i = 0; i < Count; i++)
+    {
+        order[i] = i;
+    }
+    Random().Shuffle(order, Count);
+
+    suite.Run(name, Count * 2, [&allocate, &free](Stopwatch& stopwatch)
+    {
+        static void* objects[Count];
+        stopwatch.Start();
+        for (size_t i = 0; i < Count; i++) objects[i] = allocate();
+        for (size_t i = 0; i < Count; i++) free(objects[order[i]]);
+        stopwatch.Stop();
+    });
+}
+
+/**
+ * @brief Insert Count random keys in a tree, then clear it.
+ */
+template <typename Allocator>
+static bool RunTree(Suite& suite, const char* name)
+{
+    bool found = true;
+    suite.Run(name, Count, [&found](Stopwatch& stopwatch)
+    {
+        static uint32_t keys[Count];
+        RBTree<uint32_t, uint32_t, Allocator> tree;
+        Random random;
+
+        stopwatch.Start();
+        for (size_t i = 0; i < Count; i++)
+        {
+            keys[i] = random.Next();
+            tree.Insert(keys[i], static_cast<uint32_t>(i));
+        }
+        stopwatch.Stop();
+
+        for (size_t i = 0; i < Count; i++)
+        {
+            found = found && tree.Search(keys[i]);
+        }
+
+        stopwatch.Start();
+        tree.Clear();
+        stopwatch.Stop();
+    });
+    return found;
+}
+
+/**
+ * @brief Copy short strings, as entity names or debug labels would be.
+ */
+template <typename Allocator>
+static void RunStrings(Suite& suite, const char* name)
+{
+    suite.Run(name, Count, [](Stopwatch& stopwatch)
+    {
+        const std::basic_string<Allocator> source("enemy_%d", 42);
+        stopwatch.Start();
+        for (size_t i = 0; i < Count; i++)
+        {
+            std::basic_string<Allocator> copy(source);
+            Consume(copy.c_str()[0]);
+        }
+        stopwatch.Stop();
+    });
+}
+
+/**
+ * @brief Interleave small objects with larger ones, free the small ones, then allocate 1000-byte blocks.
+ * @return Heap bytes the blocks needed beyond the memory freed by the small objects.
+ */
+template <bool Pooled>
+static size_t Fragmentation()
+{
+    static void* objects[Count];
+    static void* larger[Count];
+    static void* blocks[Count * ObjectSize / 1000];
+    BlockPool<ObjectSize, MemoryRegion::LWRAM> pool;
+
+    for (size_t i = 0; i < Count; i++)
+    {
+        objects[i] = Pooled ? pool.Allocate() : lwram::malloc(ObjectSize);
+        larger[i] = lwram::malloc(ObjectSize * 3);
+    }
+    for (size_t i = 0; i < Count; i++)
+    {
+        if (Pooled) pool.Free(objects[i]);
+        else lwram::free(objects[i]);
+    }
+    // Freed slabs go back to the heap whole, freed objects leave holes between the larger ones
+    pool.Release();
+
+    const size_t heapBefore = HeapInUse();
+    for (void*& block : blocks) block = lwram::malloc(1000);
+    const size_t growth = HeapInUse() - heapBefore;
+
+    for (void* block : blocks) lwram::free(block);
+    for (void* object : larger) lwram::free(object);
+    return growth;
+}
+
+int main(int argc, char** argv)
+{
+    Suite suite(argc, argv, "Pool allocator");
+
+    RunChurn(suite, "alloc+free/lwram::malloc", []() { return lwram::malloc(ObjectSize); }, [](void* ptr) { lwram::free(ptr); });
+
+    static Pool pool;
+    RunChurn(suite, "alloc+free/block pool", []() { return pool.Allocate(); }, [](void* ptr) { pool.Free(ptr); });
+
+    bool consistent = RunTree<HeapAllocator>(suite, "RBTree insert+clear/heap");
+    consistent = RunTree<NodePool>(suite, "RBTree insert+clear/pool") && consistent;
+
+    RunStrings<HeapAllocator>(suite, "string copy/heap");
+    RunStrings<NodePool>(suite, "string copy/pool");
+
+    if (suite.Enabled("fragmentation"))
+    {
+        const size_t blocks = Count * ObjectSize / 1000;
+        printf("%-44s %zu KiB new heap for %zu KiB of blocks\n", "fragmentation/lwram::malloc", Fragmentation<false>() / 1024, blocks * 1000 / 1024);
+        printf("%-44s %zu KiB new heap for %zu KiB of blocks\n", "fragmentation/block pool", Fragmentation<true>() / 1024, blocks * 1000 / 1024);
+    }
+
+    consistent = consistent && pool.Live() == 0;
+    if (!consistent)
+    {
+        printf("pool blocks leaked or tree lookups failed\n");
+        return 1;
+    }
+    return 0;
+}
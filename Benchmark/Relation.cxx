@@ -0,0 +1,109 @@
+#include "Bench.hpp"
+#include "../ECS/World.hpp"
+
+using namespace Hyperion::ECS;
+using namespace Hyperion::Benchmark;
+
+struct Position
+{
+    int32_t x = 0, y = 0, z = 0;
+};
+
+/**
+ * @brief Ownership kept as a plain reference field, found back by scanning the world.
+ */
+struct OwnerField
+{
+    EntityReference target;
+};
+
+/**
+ * @brief Ownership as a relation.
+ */
+struct OwnedBy {};
+
+static constexpr size_t EntityCount = 4000;
+static constexpr size_t OwnerCount = 100;
+static constexpr size_t QueryCount = 100;
+
+static EntityReference* owners = new EntityReference[OwnerCount];
+static EntityReference* entities = new EntityReference[EntityCount];
+
+int main(int argc, char** argv)
+{
+    Suite suite(argc, argv, "Relationships");
+
+    Random random;
+    for (size_t i = 0; i < OwnerCount; i++)
+    {
+        owners[i] = World::CreateEntity<Position>();
+    }
+
+    for (size_t i = 0; i < EntityCount; i++)
+    {
+        const EntityReference owner = owners[random.Next(OwnerCount)];
+        entities[i] = World::CreateEntity([owner](Position* position, OwnerField* field) { field->target = owner; });
+        World::Relate<OwnedBy>(entities[i], owner);
+    }
+
+    suite.Run("sources of target/scan", QueryCount, [](Stopwatch& stopwatch)
+    {
+        World::EntityIterator iterator;
+        size_t found = 0;
+        stopwatch.Start();
+        for (size_t i = 0; i < QueryCount; i++)
+        {
+            const EntityReference owner = owners[i % OwnerCount];
+            iterator.Iterate([&found, &owner](OwnerField* field) { found += (field->target == owner); });
+        }
+        stopwatch.Stop();
+        Consume(found);
+    });
+
+    suite.Run("sources of target/index", QueryCount, [](Stopwatch& stopwatch)
+    {
+        size_t found = 0;
+        stopwatch.Start();
+        for (size_t i = 0; i < QueryCount; i++)
+        {
+            found += World::ForEachSource<OwnedBy>(owners[i % OwnerCount], [](EntityReference source) { Consume(source); });
+        }
+        stopwatch.Stop();
+        Consume(found);
+    });
+
+    suite.Run("relate+unrelate", EntityCount, [&random](Stopwatch& stopwatch)
+    {
+        stopwatch.Start();
+        for (size_t i = 0; i < EntityCount; i++)
+        {
+            World::Unrelate<OwnedBy>(entities[i]);
+        }
+        for (size_t i = 0; i < EntityCount; i++)
+        {
+            World::Relate<OwnedBy>(entities[i], owners[random.Next(OwnerCount)]);
+        }
+        stopwatch.Stop();
+    });
+
+    suite.Run("destroy target+cleanup", OwnerCount, [](Stopwatch& stopwatch)
+    {
+        stopwatch.Start();
+        for (size_t i = 0; i < OwnerCount; i++)
+        {
+            owners[i].Destroy();
+        }
+        stopwatch.Stop();
+
+        for (size_t i = 0; i < OwnerCount; i++)
+        {
+            owners[i] = World::CreateEntity<Position>();
+        }
+        for (size_t i = 0; i < EntityCount; i++)
+        {
+            World::Relate<OwnedBy>(entities[i], owners[i % OwnerCount]);
+        }
+    });
+
+    return 0;
+}
@@ -0,0 +1,73 @@
+#include "Bench.hpp"
+#include "../ECS/World.hpp"
+
+using namespace Hyperion::ECS;
+using namespace Hyperion::Benchmark;
+
+/**
+ * @brief Per-frame global data, the kind of state systems read every frame.
+ */
+struct FrameState
+{
+    uint32_t frame = 0;
+    int32_t deltaTime = 0;
+};
+
+template <>
+struct Hyperion::ECS::WorldResources<> : ResourceList<FrameState> {};
+
+static constexpr size_t ReadCount = 10000;
+
+int main(int argc, char** argv)
+{
+    Suite suite(argc, argv, "World resources");
+
+    // Global data kept as the only entity of a one-row archetype
+    World::CreateEntity([](FrameState* state) { state->deltaTime = 1; });
+    World::Resource<FrameState>().deltaTime = 1;
+
+    suite.Run("one-row archetype/Iterate", ReadCount, [](Stopwatch& stopwatch)
+    {
+        World::EntityIterator iterator;
+        int32_t sum = 0;
+        stopwatch.Start();
+        for (size_t i = 0; i < ReadCount; i++)
+        {
+            iterator.Iterate([&sum](FrameState* state) { sum += state->deltaTime; });
+        }
+        stopwatch.Stop();
+        Consume(sum);
+    });
+
+    suite.Run("World::Resource", ReadCount, [](Stopwatch& stopwatch)
+    {
+        int32_t sum = 0;
+        stopwatch.Start();
+        for (size_t i = 0; i < ReadCount; i++)
+        {
+            sum += World::Resource<FrameState>().deltaTime;
+            Consume(sum);
+        }
+        stopwatch.Stop();
+    });
+
+    uint8_t snapshot[64];
+    suite.Run("save+load resources", 1, [&snapshot](Stopwatch& stopwatch)
+    {
+        stopwatch.Start();
+        World::SaveResources(snapshot);
+        World::LoadResources(snapshot);
+        stopwatch.Stop();
+    });
+
+    // A restore brings back the values saved, over the whole declared block
+    World::SaveResources(snapshot);
+    World::Resource<FrameState>().deltaTime = 2;
+    World::LoadResources(snapshot);
+    if (World::ResourcesSize() != sizeof(FrameState) || World::Resource<FrameState>().deltaTime != 1)
+    {
+        printf("resources not restored\n");
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,116 @@
+#include "Bench.hpp"
+#include "../ECS/World.hpp"
+
+using namespace Hyperion::ECS;
+using namespace Hyperion::Benchmark;
+
+struct Position
+{
+    int32_t x = 0, y = 0, z = 0;
+};
+
+struct Velocity
+{
+    int32_t x = 0, y = 0, z = 0;
+};
+
+struct Sprite
+{
+    int32_t slot = 0, frame = 0, palette = 0, flags = 0;
+};
+
+/**
+ * @brief Status effect toggled every few frames, stored in the archetype.
+ */
+struct Stunned
+{
+    int32_t frames = 0;
+};
+
+/**
+ * @brief Same status effect, stored in a sparse set.
+ */
+struct Frozen
+{
+    int32_t frames = 0;
+};
+
+template <>
+struct Hyperion::ECS::SparseStorage<Frozen> : std::true_type {};
+
+static constexpr size_t EntityCount = 4000;
+static constexpr size_t ToggleCount = EntityCount / 8;
+
+static EntityReference* entities = new EntityReference[EntityCount];
+static size_t* order = new size_t[EntityCount];
+
+template <typename Effect>
+static void Toggle()
+{
+    for (size_t i = 0; i < ToggleCount; i++)
+    {
+        entities[order[i]].AddComponents<Effect>();
+    }
+    for (size_t i = 0; i < ToggleCount; i++)
+    {
+        entities[order[i]].RemoveComponents<Effect>();
+    }
+}
+
+int main(int argc, char** argv)
+{
+    Suite suite(argc, argv, "Sparse set storage");
+
+    for (size_t i = 0; i < EntityCount; i++)
+    {
+        order[i] = i;
+        entities[i] = World::CreateEntity<Position, Velocity, Sprite>();
+    }
+    Random().Shuffle(order, EntityCount);
+
+    suite.Run("add+remove/archetype", ToggleCount * 2, [](Stopwatch& stopwatch)
+    {
+        stopwatch.Start();
+        Toggle<Stunned>();
+        stopwatch.Stop();
+    });
+
+    suite.Run("add+remove/sparse", ToggleCount * 2, [](Stopwatch& stopwatch)
+    {
+        stopwatch.Start();
+        Toggle<Frozen>();
+        stopwatch.Stop();
+    });
+
+    for (size_t i = 0; i < ToggleCount; i++)
+    {
+        entities[order[i]].AddComponents<Stunned>();
+        entities[order[i]].AddComponents<Frozen>();
+    }
+
+    suite.Run("iterate effect/archetype", ToggleCount, [](Stopwatch& stopwatch)
+    {
+        World::EntityIterator iterator;
+        stopwatch.Start();
+        iterator.Iterate([](Position* position, Stunned* stunned) { position->x += stunned->frames; });
+        stopwatch.Stop();
+    });
+
+    suite.Run("iterate effect/sparse", ToggleCount, [](Stopwatch& stopwatch)
+    {
+        World::EntityIterator iterator;
+        stopwatch.Start();
+        iterator.Iterate([](Position* position, Frozen* frozen) { position->x += frozen->frames; });
+        stopwatch.Stop();
+    });
+
+    suite.Run("iterate all/archetype", EntityCount, [](Stopwatch& stopwatch)
+    {
+        World::EntityIterator iterator;
+        stopwatch.Start();
+        iterator.Iterate([](Position* position, Velocity* velocity) { position->x += velocity->x; });
+        stopwatch.Stop();
+    });
+
+    return 0;
+}
@@ -0,0 +1,144 @@
+#include "Bench.hpp"
+#include "../ECS/SpatialGrid.hpp"
+
+using namespace Hyperion::ECS;
+using namespace Hyperion::Benchmark;
+
+/**
+ * @brief Position component indexed by the grid.
+ */
+struct Position : Vec3 {};
+
+static constexpr size_t EntityCounts[] = { 1000, 10000 };
+static constexpr size_t MaxEntities = 10000;
+static constexpr size_t QueryCount = 256;
+
+// 32 x 4 x 32 cells of 8 units, covering [-128, 128) x [-16, 16) x [-128, 128)
+static constexpr int16_t CellSize = 8;
+static constexpr int16_t HalfWidth = 128;
+static constexpr int16_t HalfHeight = 16;
+
+static EntityReference* entities = new EntityReference[MaxEntities];
+
+static Fxp RandomCoordinate(Random& random, int16_t halfExtent)
+{
+    return Fxp::BuildRaw(static_cast<int32_t>(random.Next(static_cast<uint32_t>(halfExtent) << 17)) - (halfExtent << 16));
+}
+
+static Vec3 RandomPoint(Random& random)
+{
+    return Vec3(RandomCoordinate(random, HalfWidth), RandomCoordinate(random, HalfHeight), RandomCoordinate(random, HalfWidth));
+}
+
+int main(int argc, char** argv)
+{
+    Suite suite(argc, argv, "Spatial grid");
+
+    SpatialGrid<Position> grid(Vec3(Fxp::FromInt(-HalfWidth), Fxp::FromInt(-HalfHeight), Fxp::FromInt(-HalfWidth)),
+        Fxp::FromInt(CellSize), 2 * HalfWidth / CellSize, 2 * HalfHeight / CellSize, 2 * HalfWidth / CellSize);
+
+    Vec3 centers[QueryCount];
+    Random pointRandom(1234);
+    for (Vec3& center : centers)
+    {
+        center = RandomPoint(pointRandom);
+    }
+
+    const Fxp radius = Fxp::FromInt(12);
+    const Vec3 extent(radius, radius, radius);
+
+    for (size_t count : EntityCounts)
+    {
+        Random random(count);
+        for (size_t i = 0; i < count; i++)
+        {
+            const Vec3 point = RandomPoint(random);
+            entities[i] = World::CreateEntity([&point](Position* position) { position->Vec3::operator=(point); });
+        }
+
+        char name[64];
+        snprintf(name, sizeof(name), "rebuild/%zu (ns/entity)", count);
+        suite.Run(name, count, [&grid](Stopwatch& stopwatch)
+        {
+            stopwatch.Start();
+            grid.Rebuild();
+            stopwatch.Stop();
+        });
+
+        grid.Rebuild();
+
+        snprintf(name, sizeof(name), "query box/%zu (ns/query)", count);
+        suite.Run(name, QueryCount, [&](Stopwatch& stopwatch)
+        {
+            size_t found = 0;
+            stopwatch.Start();
+            for (const Vec3& center : centers)
+            {
+                grid.QueryBox(center - extent, center + extent, [&found](const auto&) { found++; });
+            }
+            stopwatch.Stop();
+            Consume(found);
+        });
+
+        snprintf(name, sizeof(name), "query radius/%zu (ns/query)", count);
+        suite.Run(name, QueryCount, [&](Stopwatch& stopwatch)
+        {
+            size_t found = 0;
+            stopwatch.Start();
+            for (const Vec3& center : centers)
+            {
+                grid.QueryRadius(center, radius, [&found](const auto&) { found++; });
+            }
+            stopwatch.Stop();
+            Consume(found);
+        });
+
+        // Reference point for the radius query: test every position through the ECS
+        snprintf(name, sizeof(name), "brute force radius/%zu (ns/query)", count);
+        suite.Run(name, QueryCount, [&](Stopwatch& stopwatch)
+        {
+            const int64_t radiusSquared = static_cast<int64_t>(radius.Value()) * radius.Value();
+            size_t found = 0;
+            World::EntityIterator iterator;
+            stopwatch.Start();
+            for (const Vec3& center : centers)
+            {
+                iterator.Iterate([&](Position* position)
+                {
+                    const int64_t dx = position->x.Value() - center.x.Value();
+                    const int64_t dy = position->y.Value() - center.y.Value();
+                    const int64_t dz = position->z.Value() - center.z.Value();
+                    if (dx * dx + dy * dy + dz * dz <= radiusSquared) found++;
+                });
+            }
+            stopwatch.Stop();
+            Consume(found);
+        });
+
+        // Camera orbiting the origin at eye level, one query per step
+        snprintf(name, sizeof(name), "query frustum/%zu (ns/query)", count);
+        suite.Run(name, QueryCount, [&grid](Stopwatch& stopwatch)
+        {
+            Frustum frustum(0.125, 4.0 / 3.0, 1.0, 96.0);
+            size_t found = 0;
+            for (size_t step = 0; step < QueryCount; step++)
+            {
+                const Fxp angle = Fxp::BuildRaw(static_cast<int32_t>((step << 16) / QueryCount));
+                const Vec3 forward(Trigonometry::Sin(angle), 0.0, Trigonometry::Cos(angle));
+                frustum.Update(-forward * Fxp(64.0), forward);
+
+                stopwatch.Start();
+                grid.QueryFrustum(frustum, [&found](const auto&) { found++; });
+                stopwatch.Stop();
+            }
+            Consume(found);
+        });
+
+        for (size_t i = 0; i < count; i++)
+        {
+            entities[i].Destroy();
+        }
+    }
+
+    return 0;
+}
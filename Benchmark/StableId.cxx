@@ -0,0 +1,64 @@
+#include "Bench.hpp"
+#include "../ECS/World.hpp"
+
+using namespace Hyperion::ECS;
+using namespace Hyperion::Benchmark;
+
+template <size_t N>
+struct Data
+{
+    int32_t value = N;
+};
+
+using Signature = StableSignature<Data<0>, Data<1>, Data<2>, Data<3>, Data<4>, Data<5>, Data<6>, Data<7>>;
+
+static constexpr size_t LookupCount = 10000;
+
+int main(int argc, char** argv)
+{
+    Suite suite(argc, argv, "Stable component IDs");
+
+    // Registers the component types, as creating entities would
+    World::CreateEntity<Data<0>, Data<1>, Data<2>, Data<3>, Data<4>, Data<5>, Data<6>, Data<7>>();
+
+    suite.Run("IdFromStable", LookupCount, [](Stopwatch& stopwatch)
+    {
+        size_t sum = 0;
+        stopwatch.Start();
+        for (size_t i = 0; i < LookupCount; i++)
+        {
+            sum += Component::IdFromStable(Signature::ids.values[i & (Signature::Count - 1)]);
+            Consume(sum);
+        }
+        stopwatch.Stop();
+    });
+
+    suite.Run("BinaryIdFromStable/8 components", LookupCount, [](Stopwatch& stopwatch)
+    {
+        Component::BinaryId id = 0;
+        stopwatch.Start();
+        for (size_t i = 0; i < LookupCount; i++)
+        {
+            Component::BinaryIdFromStable(Signature::ids.values, Signature::Count, id);
+            Consume(id);
+        }
+        stopwatch.Stop();
+    });
+
+    Component::BinaryId id = 0;
+    Component::BinaryId expected = 0;
+    const bool found = Component::BinaryIdFromStable(Signature::ids.values, Signature::Count, id);
+    [&expected]<size_t... I>(Sequence<I...>) { expected = (Component::IdBinary<Data<I>> | ...); }(CreateIndexSequence<Signature::Count>{});
+    const char* first;
+    const char* second;
+    const bool collision = Component::StableIdCollision(first, second);
+    printf("%-44s %s, %s\n", "remapped signature", (found && id == expected) ? "matches" : "MISMATCH",
+        collision ? "collision" : "no collision");
+
+    if (!found || id != expected || collision)
+    {
+        if (collision) printf("stable ID collision between %s and %s\n", first, second);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,137 @@
+#include "Bench.hpp"
+#include "../ECS/World.hpp"
+#include "../ECS/StaticWorld.hpp"
+
+using namespace Hyperion::ECS;
+using namespace Hyperion::Benchmark;
+
+struct Position
+{
+    int32_t x = 0, y = 0, z = 0;
+};
+
+struct Velocity
+{
+    int32_t x = 0, y = 0, z = 0;
+};
+
+struct Health
+{
+    int32_t value = 100;
+};
+
+static constexpr size_t EntityCount = 4000;
+
+using Scene = StaticWorld<StaticArchetype<EntityCount / 2, Position, Velocity>,
+    StaticArchetype<EntityCount / 2, Position, Velocity, Health>>;
+
+static EntityReference* dynamicEntities = new EntityReference[EntityCount];
+static Scene::EntityReference* staticEntities = new Scene::EntityReference[EntityCount];
+static size_t* order = new size_t[EntityCount];
+
+static void CreateDynamic()
+{
+    for (size_t i = 0; i < EntityCount; i++)
+    {
+        dynamicEntities[i] = (i & 1) ?
+            World::CreateEntity<Position, Velocity, Health>() :
+            World::CreateEntity([](Position* position, Velocity* velocity) { velocity->x = 1; });
+    }
+}
+
+static void CreateStatic()
+{
+    for (size_t i = 0; i < EntityCount; i++)
+    {
+        staticEntities[i] = (i & 1) ?
+            Scene::CreateEntity<Position, Velocity, Health>() :
+            Scene::CreateEntity([](Position* position, Velocity* velocity) { velocity->x = 1; });
+    }
+}
+
+static void DestroyDynamic()
+{
+    for (size_t i = 0; i < EntityCount; i++)
+    {
+        dynamicEntities[order[i]].Destroy();
+    }
+}
+
+static void DestroyStatic()
+{
+    for (size_t i = 0; i < EntityCount; i++)
+    {
+        staticEntities[order[i]].Destroy();
+    }
+}
+
+int main(int argc, char** argv)
+{
+    Suite suite(argc, argv, "Static world");
+
+    for (size_t i = 0; i < EntityCount; i++)
+    {
+        order[i] = i;
+    }
+    Random().Shuffle(order, EntityCount);
+
+    suite.Run("create+destroy/dynamic", EntityCount, [](Stopwatch& stopwatch)
+    {
+        stopwatch.Start();
+        CreateDynamic();
+        DestroyDynamic();
+        stopwatch.Stop();
+    });
+
+    suite.Run("create+destroy/static", EntityCount, [](Stopwatch& stopwatch)
+    {
+        stopwatch.Start();
+        CreateStatic();
+        DestroyStatic();
+        stopwatch.Stop();
+    });
+
+    CreateDynamic();
+    CreateStatic();
+
+    suite.Run("iterate/dynamic", EntityCount, [](Stopwatch& stopwatch)
+    {
+        World::EntityIterator iterator;
+        stopwatch.Start();
+        iterator.Iterate([](Position* position, Velocity* velocity) { position->x += velocity->x; });
+        stopwatch.Stop();
+    });
+
+    suite.Run("iterate/static", EntityCount, [](Stopwatch& stopwatch)
+    {
+        Scene::EntityIterator iterator;
+        stopwatch.Start();
+        iterator.Iterate([](Position* position, Velocity* velocity) { position->x += velocity->x; });
+        stopwatch.Stop();
+    });
+
+    suite.Run("access random/dynamic", EntityCount, [](Stopwatch& stopwatch)
+    {
+        stopwatch.Start();
+        for (size_t i = 0; i < EntityCount; i++)
+        {
+            dynamicEntities[order[i]].Access([](Position* position, Velocity* velocity) { position->y += velocity->x; });
+        }
+        stopwatch.Stop();
+    });
+
+    suite.Run("access random/static", EntityCount, [](Stopwatch& stopwatch)
+    {
+        stopwatch.Start();
+        for (size_t i = 0; i < EntityCount; i++)
+        {
+            staticEntities[order[i]].Access([](Position* position, Velocity* velocity) { position->y += velocity->x; });
+        }
+        stopwatch.Stop();
+    });
+
+    DestroyDynamic();
+    DestroyStatic();
+
+    return 0;
+}
@@ -0,0 +1,16 @@
+#pragma once
+
+/**
+ * Host stand-in for libyaul's DRAM cartridge driver, reports no cartridge.
+ */
+
+#include <stddef.h>
+
+#define DRAM_CART_ID_1MIB 0x5A
+#define DRAM_CART_ID_4MIB 0x5C
+
+static inline void dram_cart_init() {}
+
+static inline int dram_cart_id_get() { return 0; }
+
+static inline size_t dram_cart_size_get() { return 0; }
@@ -0,0 +1,21 @@
+#pragma once
+
+/**
+ * Host stand-in for libyaul's TLSF allocator.
+ * Pools are only tagged, every allocation is forwarded to the system heap.
+ */
+
+#include <stdlib.h>
+
+typedef void* tlsf_t;
+
+static inline tlsf_t tlsf_pool_create(void* start, size_t size)
+{
+    return (start && size) ? start : nullptr;
+}
+
+static inline void* tlsf_malloc(tlsf_t, size_t size) { return malloc(size); }
+
+static inline void* tlsf_realloc(tlsf_t, void* ptr, size_t size) { return realloc(ptr, size); }
+
+static inline void tlsf_free(tlsf_t, void* ptr) { free(ptr); }
@@ -0,0 +1,9 @@
+#pragma once
+
+/**
+ * Host stand-in for the subset of libyaul used by the engine headers.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
@@ -0,0 +1,144 @@
+#include "Bench.hpp"
+#include "../Utils/EventManager.hpp"
+
+using namespace Hyperion::Benchmark;
+
+static constexpr uint32_t FrameTime = 16;
+static constexpr size_t Frames = 64;
+static constexpr uint32_t MaxDelay = 2000;
+
+/* Simulated clock shared by all the effects, the wheel is too */
+static uint32_t previous = 0;
+static uint32_t now = 0;
+
+/**
+ * @brief Effect of an entity expiring, each entity count is its own event type.
+ */
+template <size_t Count>
+struct Expire
+{
+    uint32_t entity;
+    uint32_t due;
+};
+
+/**
+ * @brief Entities with a countdown effect, rescheduled each time it expires.
+ */
+template <size_t Count>
+struct Effects
+{
+    static inline uint32_t dueOf[Count];
+    static inline Random random;
+    static inline bool onTime = true;
+
+    static void Schedule(uint32_t entity, uint32_t due)
+    {
+        dueOf[entity] = due;
+        EventManager::QueueEventAt(due, Expire<Count>{ entity, due });
+    }
+
+    static void OnExpire(Expire<Count>* expire)
+    {
+        const bool inFrame = static_cast<int32_t>(expire->due - previous) > 0 && static_cast<int32_t>(expire->due - now) <= 0;
+        onTime = onTime && inFrame && dueOf[expire->entity] == expire->due;
+        Schedule(expire->entity, now + 1 + random.Next(MaxDelay));
+    }
+
+    /**
+     * @return true if no effect is overdue.
+     */
+    static bool Check()
+    {
+        for (size_t entity = 0; entity < Count; entity++)
+        {
+            if (static_cast<int32_t>(dueOf[entity] - now) <= 0)
+                return false;
+        }
+        return onTime;
+    }
+};
+
+/**
+ * @brief Compare countdown components scanned every frame with events queued on the timing wheel.
+ * @return true if every timed event fired in the frame it was due.
+ */
+template <size_t Count>
+static bool Run(Suite& suite)
+{
+    char name[64];
+
+    snprintf(name, sizeof(name), "countdown scan/%zu effects", Count);
+    suite.Run(name, Frames, [](Stopwatch& stopwatch)
+    {
+        static int32_t remaining[Count];
+        Random random;
+        for (size_t entity = 0; entity < Count; entity++)
+        {
+            remaining[entity] = 1 + random.Next(MaxDelay);
+        }
+
+        size_t fired = 0;
+        stopwatch.Start();
+        for (size_t frame = 0; frame < Frames; frame++)
+        {
+            for (size_t entity = 0; entity < Count; entity++)
+            {
+                remaining[entity] -= FrameTime;
+                if (remaining[entity] <= 0)
+                {
+                    fired += entity;
+                    remaining[entity] += 1 + random.Next(MaxDelay);
+                }
+            }
+        }
+        stopwatch.Stop();
+        Consume(fired);
+    });
+
+    using State = Effects<Count>;
+    EventManager::AddListener<Expire<Count>>(&State::OnExpire);
+
+    for (uint32_t entity = 0; entity < Count; entity++)
+    {
+        State::Schedule(entity, now + 1 + State::random.Next(MaxDelay));
+    }
+
+    bool onTime = true;
+    snprintf(name, sizeof(name), "timing wheel/%zu effects", Count);
+    suite.Run(name, Frames, [&onTime](Stopwatch& stopwatch)
+    {
+        for (size_t frame = 0; frame < Frames; frame++)
+        {
+            previous = now;
+            now += FrameTime;
+
+            stopwatch.Start();
+            EventManager::ProcessTimedEvents(now);
+            EventManager::ProcessQueuedEvents();
+            stopwatch.Stop();
+
+            onTime = onTime && State::Check();
+        }
+    });
+    return onTime;
+}
+
+int main(int argc, char** argv)
+{
+    Suite suite(argc, argv, "Timed events (per 16 ms frame)");
+    SystemTime::Initialize();
+
+    // The simulated clock runs ahead of SystemTime, so the wheel never skips to it
+    now = SystemTime::CurrentTime() + 1;
+
+    bool onTime = Run<256>(suite);
+    onTime = Run<4096>(suite) && onTime;
+    onTime = Run<32768>(suite) && onTime;
+
+    if (!onTime)
+    {
+        printf("timed events late or early\n");
+        return 1;
+    }
+    return 0;
+}
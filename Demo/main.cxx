@@ -1,6 +1,6 @@
 
 #include "yaul.h"
-#include "..\ECS\World.hpp"
+#include "../ECS/World.hpp"
 
 static inline const auto init = []()
 {
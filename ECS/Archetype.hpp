@@ -3,11 +3,14 @@
 #include <stdint.h>
 #include <stddef.h>
 
-#include "..\Utils\SatAlloc.hpp"
-#include "..\Utils\std\vector.h"
+#include "../Utils/SatAlloc.hpp"
+#include "../Utils/std/vector.h"
 
 #include "EntityRecord.hpp"
 #include "Component.hpp"
+#include "Hooks.hpp"
+#include "SparseSet.hpp"
+#include "GroupStorage.hpp"
 
 namespace Hyperion::ECS
 {
@@ -26,9 +29,17 @@ namespace Hyperion::ECS
     {
         friend class EntityReference;
         friend class World;
+        template <typename... Ts>
+        friend class OwningGroup;
 
         static inline std::vector<ArchetypeManager> managers;
 
+        /**
+         * @brief Counter bumped by every structural change: new archetype, row added or removed.
+         * Cached query results are valid as long as it does not change.
+         */
+        static inline uint32_t structuralEpoch = 1;
+
         /**
          * @brief Finds the index of the archetype manager associated with a specific component binary identifier.
          * @param id The binary identifier of the components.
@@ -44,18 +55,69 @@ namespace Hyperion::ECS
             }
 
             managers.push_back(std::move(ArchetypeManager(id)));
+            structuralEpoch++;
+
+            for (size_t group = 0; group < GroupStorage::groupCount; group++)
+            {
+                managers[size].JoinGroup(group);
+            }
 
             return size;
         }
 
+        /**
+         * @brief Get the binary identifier a component type contributes to an archetype signature.
+         * @tparam T The component type.
+         * @return The binary identifier, 0 for sparse components.
+         */
+        template <typename T>
+        static Component::BinaryId SignatureOf()
+        {
+            if constexpr (SparseComponent<T>)
+            {
+                return 0;
+            }
+            else
+            {
+                // Computed from the ID rather than read from IdBinary, whose dynamic initialization may not have run yet
+                (void)Component::IdBinary<T>;
+                return Component::BinaryId(1) << Component::Id<T>;
+            }
+        }
+
         /**
          * @brief Helper struct for managing components.
+         * Sparse components are left out of the binary identifier, they live in their SparseSet.
          * @tparam T The component types.
          */
         template <typename... T>
         struct HelperImplementation
         {
-            static inline Component::BinaryId id = (Component::IdBinary<T> | ...);
+            static inline Component::BinaryId id = (SignatureOf<T>() | ...);
+
+            /**
+             * @brief Add the sparse components of the list to a record.
+             * @param record The index of the entity record.
+             */
+            static void AddSparse(Index record)
+            {
+                ([record]()
+                {
+                    if constexpr (SparseComponent<T>) SparseSet<T>::Add(record);
+                }(), ...);
+            }
+
+            /**
+             * @brief Remove the sparse components of the list from a record.
+             * @param record The index of the entity record.
+             */
+            static void RemoveSparse(Index record)
+            {
+                ([record]()
+                {
+                    if constexpr (SparseComponent<T>) SparseSet<T>::Remove(record);
+                }(), ...);
+            }
 
             /**
              * @brief Get the instance of the archetype manager.
@@ -134,6 +196,83 @@ namespace Hyperion::ECS
         template <class... Ts>
         using LookupCache = instantiate_t<LookupCacheImplementation, sorted_list_t<list<Ts...>>>;
 
+        template <typename T>
+        class Column;
+
+        /**
+         * @brief Flattened result of a query, rebuilt when the structural epoch changes.
+         *
+         * Holds, for each non-empty matching archetype, its row count and the base pointer of
+         * every requested column, so repeated iterations in an unchanged frame go straight to
+         * the data. Keyed by the query types in lambda order, since the bases follow it.
+         * @tparam T The query types.
+         */
+        template <typename... T>
+        struct QueryCache
+        {
+            /**
+             * @brief A matching archetype and the base of each requested column.
+             */
+            struct Entry
+            {
+                Index archetype;
+                Index size;
+                void* bases[sizeof...(T)];
+            };
+
+            static inline Entry* entries = nullptr;
+            static inline size_t count = 0;
+            static inline size_t capacity = 0;
+            static inline uint32_t epoch = 0;
+
+            /**
+             * @brief Rebuild the cached entries if the world changed structurally since the last update.
+             * @return false if the entries could not grow, the query must then walk LookupCache instead.
+             */
+            static bool Update()
+            {
+                if (epoch == structuralEpoch) return true;
+
+                using Lookup = LookupCache<T...>;
+                Lookup::Update();
+
+                count = 0;
+                if (capacity < Lookup::matchedIndices.size())
+                {
+                    Entry* newEntries = static_cast<Entry*>(realloc(entries, sizeof(Entry) * Lookup::matchedIndices.size()));
+                    if (!newEntries) return false;
+
+                    entries = newEntries;
+                    capacity = Lookup::matchedIndices.size();
+                }
+
+                for (size_t managerIndex : Lookup::matchedIndices)
+                {
+                    const ArchetypeManager& manager = managers[managerIndex];
+                    if (manager.size)
+                    {
+                        entries[count++] = { static_cast<Index>(managerIndex), manager.size, { Column<T>::Base(manager)... } };
+                    }
+                }
+                epoch = structuralEpoch;
+                return true;
+            }
+
+            /**
+             * @brief Call a function with a cursor on the first row of each requested column of an entry.
+             * @param entry The cached entry.
+             * @param body Function taking a Column per query type.
+             */
+            template <typename Body>
+            static void WithColumns(const Entry& entry, Body body)
+            {
+                [&entry, &body]<size_t... I>(Sequence<I...>)
+                {
+                    body(Column<T>(entry.bases[I])...);
+                }(CreateIndexSequence<sizeof...(T)>{});
+            }
+        };
+
         Index GetIndex() { return static_cast<Index>(this - &(*managers.begin())); }
 
         Component::BinaryId id;
@@ -146,6 +285,8 @@ namespace Hyperion::ECS
         InternalIndex internalIndex[Component::MaxComponentTypes] = { Unused };
         Index capacity = 0;
         Index size = 0;
+        Component::BinaryId grouped = 0;    /**< Components whose columns live in a GroupStorage. */
+        uint8_t groupMask = 0;              /**< Groups the archetype participates in. */
 
         /**
          * @brief Iterate over each component in a binary identifier.
@@ -195,7 +336,16 @@ namespace Hyperion::ECS
         template <typename T>
         T* GetComponentArray() const
         {
-            return static_cast<T*>(componentArrays[internalIndex[Component::Id<T>]]);
+            void* column = componentArrays[internalIndex[Component::Id<T>]];
+            if constexpr (FieldType<T>)
+            {
+                return SplitStorage<typename T::Component>::template FieldArray<T::Member>(column);
+            }
+            else
+            {
+                static_assert(!SplitComponent<T>, "Split components are accessed through a Column or Field<&T::member>.");
+                return static_cast<T*>(column);
+            }
         }
 
         /**
@@ -207,11 +357,116 @@ namespace Hyperion::ECS
         template <typename T>
         T* GetComponent(Index row) const
         {
-            auto index = internalIndex[TypeInfo::ID<T>];
-            return (index == Unused) ? nullptr :
-                &((static_cast<T*>(componentArrays[index]))[row]);
+            auto index = internalIndex[Component::Id<T>];
+            return (index == Unused) ? nullptr : &GetComponentArray<T>()[row];
         }
 
+        /**
+         * @brief Cursor over one component column, handing out a pointer per row.
+         * @tparam T The component or field type.
+         */
+        template <typename T>
+        class Column
+        {
+            T* current;
+
+        public:
+            /**
+             * @brief Position the cursor on a row, or on nothing if the archetype lacks the component.
+             * @param archetype The archetype owning the column.
+             * @param row The starting row.
+             */
+            Column(const ArchetypeManager& archetype, Index row) : current(archetype.GetComponent<T>(row)) {}
+
+            /**
+             * @brief Position the cursor on the first row of a column base cached by QueryCache.
+             */
+            explicit Column(void* base) : current(static_cast<T*>(base)) {}
+
+            /**
+             * @brief Get what identifies the column of an archetype, for QueryCache.
+             */
+            static void* Base(const ArchetypeManager& archetype) { return archetype.GetComponent<T>(0); }
+
+            T* Get() { return current; }
+
+            /**
+             * @brief Write back anything staged by Get, nothing to do for in-place columns.
+             */
+            void Store() {}
+
+            void Next() { ++current; }
+        };
+
+        /**
+         * @brief Cursor over a split component requested as a whole struct.
+         * Get gathers the fields of the row into a staging copy, Store scatters it back.
+         * @tparam T The split component type.
+         */
+        template <SplitComponent T>
+        class Column<T>
+        {
+            void* column = nullptr;
+            Index row;
+            T staging{};
+
+        public:
+            Column(const ArchetypeManager& archetype, Index row) : column(Base(archetype)), row(row) {}
+
+            explicit Column(void* base) : column(base), row(0) {}
+
+            static void* Base(const ArchetypeManager& archetype)
+            {
+                auto index = archetype.internalIndex[Component::Id<T>];
+                return (index != Unused) ? archetype.componentArrays[index] : nullptr;
+            }
+
+            T* Get()
+            {
+                if (!column) return nullptr;
+
+                // Members left out of the layout are not stored, reset what the previous row may have written
+                if constexpr (!SplitStorage<T>::Complete) staging = T{};
+                SplitStorage<T>::Gather(column, row, staging);
+                return &staging;
+            }
+
+            void Store()
+            {
+                if (column) SplitStorage<T>::Scatter(column, row, staging);
+            }
+
+            void Next()
+            {
+                Store();
+                ++row;
+            }
+        };
+
+        /**
+         * @brief Cursor over a sparse component, looked up through the record of each row.
+         * @tparam T The sparse component type.
+         */
+        template <SparseComponent T>
+        class Column<T>
+        {
+            const Index* records;
+            Index row;
+
+        public:
+            Column(const ArchetypeManager& archetype, Index row) : records(archetype.recordIndices), row(row) {}
+
+            explicit Column(void* base) : records(static_cast<const Index*>(base)), row(0) {}
+
+            static void* Base(const ArchetypeManager& archetype) { return archetype.recordIndices; }
+
+            T* Get() { return SparseSet<T>::Find(records[row]); }
+
+            void Store() {}
+
+            void Next() { ++row; }
+        };
+
     public:
         /**
          * @brief Default constructor.
@@ -227,7 +482,9 @@ namespace Hyperion::ECS
             recordIndices(std::move(other.recordIndices)),
             componentArrays(std::move(other.componentArrays)),
             capacity(std::move(other.capacity)),
-            size(std::move(other.size))
+            size(std::move(other.size)),
+            grouped(other.grouped),
+            groupMask(other.groupMask)
         {
             for (size_t i = 0; i < Component::MaxComponentTypes; ++i)
             {
@@ -241,6 +498,8 @@ namespace Hyperion::ECS
             other.componentArrays = nullptr;
             other.capacity = 0;
             other.size = 0;
+            other.grouped = 0;
+            other.groupMask = 0;
         }
 
         /**
@@ -257,6 +516,8 @@ namespace Hyperion::ECS
                 componentArrays = std::move(other.componentArrays);
                 capacity = std::move(other.capacity);
                 size = std::move(other.size);
+                grouped = other.grouped;
+                groupMask = other.groupMask;
 
                 for (size_t i = 0; i < Component::MaxComponentTypes; ++i)
                 {
@@ -270,6 +531,8 @@ namespace Hyperion::ECS
                 other.componentArrays = nullptr;
                 other.capacity = 0;
                 other.size = 0;
+                other.grouped = 0;
+                other.groupMask = 0;
             }
 
             return *this;
@@ -282,6 +545,11 @@ namespace Hyperion::ECS
          */
         ArchetypeManager(Component::BinaryId newId) : id(newId)
         {
+            for (size_t i = 0; i < Component::MaxComponentTypes; ++i)
+            {
+                internalIndex[i] = Unused;
+            }
+
             uint8_t localComponentCount = 0;
             EachComponent(newId, [this, &localComponentCount](size_t componentId)
             {
@@ -291,38 +559,110 @@ namespace Hyperion::ECS
             componentArrays = new void* [localComponentCount]();
         }
 
+        /**
+         * @brief Move the columns owned by a group into its storage, if the archetype holds all of them.
+         * @param group The index of the group in GroupStorage::groups.
+         * @return true if the archetype now participates in the group.
+         */
+        bool JoinGroup(size_t group)
+        {
+            GroupStorage& storage = *GroupStorage::groups[group];
+            if (!Contains(storage.owned)) return false;
+
+            void** slots[GroupStorage::MaxOwned];
+            for (size_t c = 0; c < storage.ownedCount; c++)
+            {
+                slots[c] = &componentArrays[internalIndex[storage.componentIds[c]]];
+            }
+
+            if (!storage.Join(GetIndex(), capacity, slots)) return false;
+
+            grouped |= storage.owned;
+            groupMask |= static_cast<uint8_t>(1 << group);
+            structuralEpoch++;
+            return true;
+        }
+
         /**
          * @brief Reserve an EntityRecord within the archetype.
-         * @return The reserved EntityRecord.
+         * @return The reserved EntityRecord, or nullptr if no record is left or the archetype cannot grow.
          */
-        EntityRecord& ReserveRecord()
+        EntityRecord* ReserveRecord()
         {
-            EntityRecord& entityRecord = EntityRecord::Reserve();
+            EntityRecord* reserved = EntityRecord::Reserve();
+            if (!reserved) return nullptr;
 
-            if (size >= capacity)
+            EntityRecord* record = ReserveRow(*reserved);
+            if (!record)
             {
-                capacity = (capacity == 0) ? 2 : (capacity * 2) - (capacity / 2);
-                recordIndices = static_cast<Index*>(realloc(recordIndices, sizeof(Index) * capacity));
+                reserved->Release();
+                return nullptr;
+            }
 
-                EachComponent(id, [this](const size_t& componentId)
-                {
-                    Component::ResizeArray(componentId, &componentArrays[internalIndex[componentId]], capacity, size);
-                });
+            ComponentHooks::Record(ComponentHooks::Add, id, *record);
+            return record;
+        }
+
+        /**
+         * @brief Grow the columns of the archetype, all of them or none.
+         * Columns grown before a failure keep their larger size, which the capacity does not count.
+         * Grouped columns are segments of a shared store: growing one shifts the segments after it,
+         * moving the columns of the other archetypes of the group.
+         * @return true if the archetype holds more rows.
+         */
+        bool Grow()
+        {
+            // Grow in size_t, a row is a record index so InvalidIndex rows are never needed
+            if (capacity == InvalidIndex) return false;
+            const size_t grown = (capacity == 0) ? 2 : (size_t(capacity) * 2) - (capacity / 2);
+            const Index newCapacity = static_cast<Index>(grown < InvalidIndex ? grown : InvalidIndex);
+
+            Index* newRecordIndices = static_cast<Index*>(realloc(recordIndices, sizeof(Index) * newCapacity));
+            if (!newRecordIndices) return false;
+            recordIndices = newRecordIndices;
+
+            bool resized = true;
+            EachComponent(id & ~grouped, [this, newCapacity, &resized](const size_t& componentId)
+            {
+                resized = resized && Component::ResizeArray(componentId, &componentArrays[internalIndex[componentId]], newCapacity, size);
+            });
+            if (!resized) return false;
+
+            for (size_t group = 0; group < GroupStorage::groupCount; group++)
+            {
+                if ((groupMask & (1 << group)) && !GroupStorage::groups[group]->Grow(GetIndex(), newCapacity)) return false;
             }
+
+            capacity = newCapacity;
+            return true;
+        }
+
+        /**
+         * @brief Reserve a row within the archetype for an existing EntityRecord.
+         * @param entityRecord The EntityRecord that will own the row.
+         * @return The updated EntityRecord, or nullptr if the archetype cannot grow.
+         */
+        EntityRecord* ReserveRow(EntityRecord& entityRecord)
+        {
+            if (size >= capacity && !Grow()) return nullptr;
+
             recordIndices[size] = entityRecord.GetIndex();
+            structuralEpoch++;
 
             entityRecord.archetype = static_cast<Index>(GetIndex());
             entityRecord.row = size++;
 
-            return entityRecord;
+            return &entityRecord;
         }
 
         /**
-         * @brief Remove a row from the archetype.
-         * @param row The row index to remove.
+         * @brief Detach a row from the archetype without releasing its EntityRecord.
+         * The last row is moved into the vacated slot to keep the columns packed.
+         * @param row The row index to detach.
          */
-        void RemoveRow(Index row)
+        void DetachRow(Index row)
         {
+            structuralEpoch++;
             if (size) size--;
             Index lastRow = size;
             if (row != lastRow)
@@ -333,29 +673,66 @@ namespace Hyperion::ECS
                     Component::MoveElement(componentId, arrayPtr, row, arrayPtr, lastRow);
                 });
 
-                EntityRecord::records[recordIndices[row]].Release();
                 EntityRecord::records[recordIndices[lastRow]].row = row;
                 recordIndices[row] = recordIndices[lastRow];
             }
         }
 
+        /**
+         * @brief Record the removal of hooked components of an entity still located in this archetype.
+         * @param removed The binary identifier of the removed components.
+         * @param record The EntityRecord of the entity.
+         */
+        void RecordRemovals(Component::BinaryId removed, const EntityRecord& record)
+        {
+            removed &= ComponentHooks::masks[ComponentHooks::Remove];
+            if (removed)
+            {
+                EachComponent(removed, [this, &record](size_t componentId)
+                {
+                    ComponentHooks::RecordRemoval(componentId, record, componentArrays[internalIndex[componentId]]);
+                });
+            }
+        }
+
+        /**
+         * @brief Remove a row from the archetype, releasing its EntityRecord.
+         * @param row The row index to remove.
+         */
+        void RemoveRow(Index row)
+        {
+            EntityRecord& record = EntityRecord::records[recordIndices[row]];
+            RecordRemovals(id, record);
+            SparseSets::RemoveAll(record.GetIndex());
+            DetachRow(row);
+            record.Release();
+        }
+
         /**
          * @brief Move an entity from another archetype into this archetype.
+         * The entity keeps its EntityRecord, so existing references remain valid.
          * @param sourceArchetype The source archetype.
          * @param sourceRow The source row within the source archetype.
-         * @return The EntityRecord for the moved entity.
+         * @return The EntityRecord for the moved entity, or nullptr if this archetype cannot grow, the entity then stays in place.
          */
-        EntityRecord& MoveEntity(ArchetypeManager* sourceArchetype, size_t sourceRow)
+        EntityRecord* MoveEntity(ArchetypeManager* sourceArchetype, size_t sourceRow)
         {
-            EntityRecord& record = ReserveRecord();
+            if (size >= capacity && !Grow()) return nullptr;
+
+            EntityRecord& record = EntityRecord::records[sourceArchetype->recordIndices[sourceRow]];
+            sourceArchetype->RecordRemovals(sourceArchetype->id & ~id, record);
+
+            ReserveRow(record);
             EachCommonComponent(id, sourceArchetype->id, [this, &record, sourceArchetype, sourceRow](size_t componentId)
             {
                 void* arrayPtr = componentArrays[internalIndex[componentId]];
                 void* srcArrayPtr = sourceArchetype->componentArrays[sourceArchetype->internalIndex[componentId]];
                 Component::MoveElement(componentId, arrayPtr, record.row, srcArrayPtr, sourceRow);
             });
-            sourceArchetype->RemoveRow(sourceRow);
-            return record;
+            sourceArchetype->DetachRow(sourceRow);
+
+            ComponentHooks::Record(ComponentHooks::Add, id & ~sourceArchetype->id, record);
+            return &record;
         }
     };
 }
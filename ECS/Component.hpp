@@ -3,11 +3,27 @@
 #include <stdint.h>
 #include <stddef.h>
 #include <limits.h>
+#include <assert.h>
 
-#include "..\Utils\std\vector.h"
+#include "../Utils/std/vector.h"
+#include "Layout.hpp"
 
 namespace Hyperion::ECS
 {
+    /**
+     * @brief Stable ID trait, the FNV-1a hash of the component type name unless specialized.
+     *
+     * Stable IDs do not depend on instantiation order, so they can be written to snapshots and
+     * asset files. Specialize it to keep the ID of a renamed component, or to resolve a
+     * collision, e.g. `template <> struct Hyperion::ECS::StableIdOf<Health> { static constexpr uint32_t value = 0x4a1d2c3b; };`.
+     * @tparam T The component type.
+     */
+    template <typename T>
+    struct StableIdOf
+    {
+        static constexpr uint32_t value = TypeNameHash<T>();
+    };
+
     /**
      * @brief Base class for ECS components.
      */
@@ -146,17 +162,107 @@ namespace Hyperion::ECS
 
         static inline std::vector<Operation> OperationList;    /**< Vector to hold operation function pointers. */
 
+        /**
+         * @brief Slot of the open addressing table mapping stable IDs to dense IDs.
+         */
+        struct StableSlot
+        {
+            uint32_t stableId;
+            uint8_t id;                 /**< MaxComponentTypes once two types collided on the stable ID. */
+            bool used;
+            const char* typeName;
+        };
+
+        static constexpr size_t StableTableSize = 128;      /**< Twice the maximum number of component types, a power of two. */
+        static inline StableSlot stableTable[StableTableSize] = {};
+        static inline const char* collidingTypes[2] = {};  /**< Names of the first two types found to share a stable ID. */
+
+        /**
+         * @brief Add a component type to the stable ID table.
+         * A type whose stable ID is taken by another type is refused, and the stable ID then
+         * resolves to neither of them, so persisted data fails to load instead of being mapped to the
+         * wrong type. Debug builds stop on the assert, StableIdCollision names the types.
+         * @param stableId The stable ID of the component type.
+         * @param id The dense ID of the component type.
+         * @param typeName The name of the component type.
+         * @return false if another type has the same stable ID.
+         */
+        static bool RegisterStableId(uint32_t stableId, size_t id, const char* typeName)
+        {
+            size_t slot = stableId & (StableTableSize - 1);
+            while (stableTable[slot].used)
+            {
+                if (stableTable[slot].stableId == stableId)
+                {
+                    if (stableTable[slot].id == id) return true;
+
+                    if (!collidingTypes[0])
+                    {
+                        collidingTypes[0] = stableTable[slot].typeName;
+                        collidingTypes[1] = typeName;
+                    }
+                    stableTable[slot].id = static_cast<uint8_t>(MaxComponentTypes);
+                    assert(!"Stable component ID collision, specialize StableIdOf for one of the types");
+                    return false;
+                }
+                slot = (slot + 1) & (StableTableSize - 1);
+            }
+            stableTable[slot] = { stableId, static_cast<uint8_t>(id), true, typeName };
+            return true;
+        }
+
+        /**
+         * @brief Unique ID of a concrete component type.
+         *
+         * @tparam T The type of the component.
+         */
+        template <typename T>
+        static inline constexpr size_t UniqueId = GetNextID < [] {} > ();
+
+        /**
+         * @brief Registers the array operations of a component type.
+         *
+         * @tparam T The type of the component.
+         * @return The binary ID of the component.
+         */
+        template <typename T>
+        static uint64_t Register()
+        {
+            constexpr size_t id = UniqueId<T>;
+            constexpr size_t size = id + 1;
+
+            if (OperationList.size() < size)
+            {
+                OperationList.resize(size);
+            }
+
+            if constexpr (SplitComponent<T>)
+            {
+                using Storage = SplitStorage<T>;
+                OperationList[id] = Operation(&Storage::DeleteArray, &Storage::MoveElement, &Storage::ResizeArray);
+            }
+            else
+            {
+                OperationList[id] = Operation(&DeleteArray<T>, &MoveElement<T>, &ResizeArray<T>);
+            }
+
+            RegisterStableId(StableIdOf<T>::value, id, TypeName<T>());
+
+            return (uint64_t)1 << id;
+        }
+
     public:
         using BinaryId = uint64_t;                          /**< Alias for component ID in binary format. */
         static inline constexpr size_t MaxComponentTypes = sizeof(BinaryId) * CHAR_BIT;   /**< Maximum number of component types. */
 
         /**
          * @brief Retrieves the ID of a component type.
+         * A Field<&T::member> query type shares the ID of its owning component T.
          *
          * @tparam T The type of the component.
          */
         template <typename T>
-        static inline constexpr size_t Id = GetNextID < [] {} > ();
+        static inline constexpr size_t Id = UniqueId<ComponentOf<T>>;
 
         /**
          * @brief Retrieves the binary ID of a component type.
@@ -164,20 +270,69 @@ namespace Hyperion::ECS
          * @tparam T The type of the component.
          */
         template <typename T>
-        static inline BinaryId IdBinary = []()
-        {
-            constexpr size_t id = Id<T>;
-            constexpr size_t size = id + 1;
+        static inline BinaryId IdBinary = Register<ComponentOf<T>>();
 
-            if (OperationList.size() < size)
+        /**
+         * @brief Retrieves the stable ID of a component type, to be used in persisted data.
+         * A Field<&T::member> query type shares the stable ID of its owning component T.
+         *
+         * @tparam T The type of the component.
+         */
+        template <typename T>
+        static inline constexpr uint32_t StableId = StableIdOf<ComponentOf<T>>::value;
+
+        /**
+         * @brief Retrieves the dense ID of a registered component type from its stable ID.
+         *
+         * @param stableId The stable ID of the component type.
+         * @return The ID of the component type, or MaxComponentTypes if no registered type, or more than one, has this stable ID.
+         */
+        static size_t IdFromStable(uint32_t stableId)
+        {
+            size_t slot = stableId & (StableTableSize - 1);
+            while (stableTable[slot].used)
             {
-                OperationList.resize(size);
+                if (stableTable[slot].stableId == stableId) return stableTable[slot].id;
+                slot = (slot + 1) & (StableTableSize - 1);
             }
+            return MaxComponentTypes;
+        }
 
-            OperationList[id] = Operation(&DeleteArray<T>, &MoveElement<T>, &ResizeArray<T>);
+        /**
+         * @brief Converts a persisted list of stable IDs, such as an archetype signature, to a binary ID.
+         *
+         * @param stableIds The stable IDs.
+         * @param count The number of stable IDs.
+         * @param id Receives the binary ID.
+         * @return true If every stable ID belongs to a registered component type.
+         * @return false Otherwise.
+         */
+        static bool BinaryIdFromStable(const uint32_t* stableIds, size_t count, BinaryId& id)
+        {
+            id = 0;
+            for (size_t i = 0; i < count; i++)
+            {
+                const size_t componentId = IdFromStable(stableIds[i]);
+                if (componentId == MaxComponentTypes) return false;
+                id |= BinaryId(1) << componentId;
+            }
+            return true;
+        }
 
-            return (BinaryId)1 << id;
-        }();
+        /**
+         * @brief Checks whether two registered component types were found to share a stable ID.
+         * Neither of them resolves from that stable ID, one of them must specialize StableIdOf.
+         *
+         * @param first Receives the name of the type registered first.
+         * @param second Receives the name of the type refused.
+         * @return true If a collision was detected.
+         */
+        static bool StableIdCollision(const char*& first, const char*& second)
+        {
+            first = collidingTypes[0];
+            second = collidingTypes[1];
+            return first != nullptr;
+        }
 
         /**
          * @brief Deletes an array of a specific component type.
@@ -220,4 +375,58 @@ namespace Hyperion::ECS
         }
 
     };
+
+    /**
+     * @brief Sorted stable IDs of a set of component types, computed at compile time.
+     *
+     * Used to precompute archetype layouts and persist signatures; two of the types sharing a
+     * stable ID is a compile error.
+     * @tparam Ts The component types.
+     */
+    template <typename... Ts>
+    struct StableSignature
+    {
+        static_assert(sizeof...(Ts) > 0, "A stable signature needs at least one component type.");
+
+        static constexpr size_t Count = sizeof...(Ts);
+
+        /**
+         * @brief Array wrapper, so the IDs can be built by a constexpr function.
+         */
+        struct Ids
+        {
+            uint32_t values[Count];
+        };
+
+    private:
+        static constexpr Ids Sort()
+        {
+            Ids ids = { { Component::StableId<Ts>... } };
+            for (size_t i = 1; i < Count; i++)
+            {
+                const uint32_t value = ids.values[i];
+                size_t j = i;
+                for (; j > 0 && ids.values[j - 1] > value; j--)
+                {
+                    ids.values[j] = ids.values[j - 1];
+                }
+                ids.values[j] = value;
+            }
+            return ids;
+        }
+
+        static constexpr bool Distinct(const Ids& ids)
+        {
+            for (size_t i = 1; i < Count; i++)
+            {
+                if (ids.values[i - 1] == ids.values[i]) return false;
+            }
+            return true;
+        }
+
+    public:
+        static constexpr Ids ids = Sort();    /**< Stable IDs in ascending order. */
+
+        static_assert(Distinct(ids), "Stable component ID collision, specialize StableIdOf for one of the types.");
+    };
 }
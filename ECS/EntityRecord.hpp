@@ -4,7 +4,34 @@
 #include <stddef.h>
 
 #include <stdlib.h>
-#include "..\Utils\HierarchicalBitset.hpp"
+#include "../Utils/SatAlloc.hpp"
+
+#ifndef HYPERION_RECORD_CHUNK_BITS
+/**
+ * @brief Entity records are allocated in chunks of 2^HYPERION_RECORD_CHUNK_BITS records.
+ */
+#define HYPERION_RECORD_CHUNK_BITS 8
+#endif
+
+#ifndef HYPERION_RECORD_REUSE_FIFO
+/**
+ * @brief Reuse policy of released entity records.
+ * 1 reuses the record released the longest ago first (FIFO), spreading version increments over
+ * all records so 16-bit versions wrap around as late as possible. 0 reuses the record released
+ * last (LIFO), keeping the records in use close together.
+ */
+#define HYPERION_RECORD_REUSE_FIFO 1
+#endif
+
+#ifndef HYPERION_RECORD_WIDE_GENERATION
+/**
+ * @brief Widen entity generations with a 16-bit epoch kept in a cold array beside the records.
+ * 0 retires a record for good once its 16-bit version is exhausted. 1 starts a new epoch instead,
+ * keeping the record in use, at the cost of 2 more bytes per EntityReference and an epoch check
+ * for references whose version matches.
+ */
+#define HYPERION_RECORD_WIDE_GENERATION 0
+#endif
 
 namespace Hyperion::ECS
 {
@@ -19,81 +46,143 @@ namespace Hyperion::ECS
         friend class EntityReference;
         friend class World;
         friend class ArchetypeManager;
+        friend class ComponentHooks;
+
+        /**
+         * @brief Records stored in fixed-size chunks, growing never moves existing records.
+         */
+        struct Table
+        {
+            static constexpr size_t ChunkBits = HYPERION_RECORD_CHUNK_BITS;
+            static constexpr size_t ChunkSize = size_t(1) << ChunkBits;
+            static constexpr size_t MaxChunks = (size_t(InvalidIndex) + ChunkSize - 1) / ChunkSize;
+
+            EntityRecord* chunks[MaxChunks];
+#if HYPERION_RECORD_WIDE_GENERATION
+            Index* epochs[MaxChunks];       /**< High half of each record generation, read only when the version matches. */
+
+            Index& Epoch(size_t index) const
+            {
+                return epochs[index >> ChunkBits][index & (ChunkSize - 1)];
+            }
+#endif
+
+            EntityRecord& operator[](size_t index) const
+            {
+                return chunks[index >> ChunkBits][index & (ChunkSize - 1)];
+            }
+        };
 
         static inline size_t capacity = 0;
         static inline size_t last = 0;
-        static inline HierarchicalBitset recycleBin;
-        static inline EntityRecord* records = nullptr;
+        static inline Index freeHead = InvalidIndex;    /**< Next record to reuse, released records are linked through row. */
+        static inline Index freeTail = InvalidIndex;    /**< Last released record, where FIFO reuse appends. */
+        static inline size_t retired = 0;               /**< Records whose generations are exhausted, never reused. */
+        static inline Table records;
 
         /**
-         * @brief Reserves an entity record, creating a new one or reusing an existing one.
-         * @return The reserved EntityRecord.
+         * @brief Reserves an entity record, reusing a released one or taking a new one.
+         * @return The reserved EntityRecord, or nullptr if every record index is in use or retired,
+         * or if memory ran out.
          */
-        static EntityRecord& Reserve()
+        static EntityRecord* Reserve()
         {
-            size_t index;
-            if (last < capacity)
+            Index index;
+            if (freeHead != InvalidIndex)
             {
-                index = last++;
-            }
-            else if (recycleBin.LookupSetPos(index))
-            {
-                recycleBin.Clear(index);
+                index = freeHead;
+                freeHead = records[index].row;
+                if (freeHead == InvalidIndex) freeTail = InvalidIndex;
             }
             else
             {
-                size_t originalCapacity = capacity;
-                capacity = (capacity == 0) ? 2 : (capacity * 2) - (capacity / 2);
+                // InvalidIndex is never handed out, retired records keep their index for good
+                if (last >= InvalidIndex) return nullptr;
 
-                EntityRecord* newArray = new EntityRecord[capacity];
-                if (!newArray)
+                if (last >= capacity)
                 {
-                    /* TO-DO implement proper error handling*/
-                }
-
-                for (Index i = 0; i < originalCapacity; ++i)
-                {
-                    newArray[i] = std::move(records[i]);
-                }
-
-                delete[] records;
+                    EntityRecord* chunk = new EntityRecord[Table::ChunkSize];
+                    if (!chunk) return nullptr;
 
-                index = last++;
+#if HYPERION_RECORD_WIDE_GENERATION
+                    Index* epochs = static_cast<Index*>(calloc(Table::ChunkSize, sizeof(Index)));
+                    if (!epochs)
+                    {
+                        delete[] chunk;
+                        return nullptr;
+                    }
+                    records.epochs[capacity >> Table::ChunkBits] = epochs;
+#endif
+                    for (size_t i = 0; i < Table::ChunkSize; i++)
+                    {
+                        chunk[i].index = static_cast<Index>(capacity + i);
+                    }
 
-                records = newArray;
+                    records.chunks[capacity >> Table::ChunkBits] = chunk;
+                    capacity += Table::ChunkSize;
+                }
+                index = static_cast<Index>(last++);
             }
-            return records[index];
+
+            EntityRecord& record = records[index];
+            record.row = InvalidIndex;
+            return &record;
         }
 
         Index archetype = InvalidIndex;
-        Index row = InvalidIndex;
+        Index row = InvalidIndex;       /**< Row in the archetype, or next released record while free. */
         Index version = 0;
+        Index index = InvalidIndex;
 
         /**
          * @brief Get the index of the EntityRecord.
          * @return The index of the EntityRecord.
          */
-        Index GetIndex() const { return static_cast<Index>(this - records); }
+        Index GetIndex() const { return index; }
 
         /**
          * @brief Releases the entity record, making it available for reuse.
+         * A version is never handed out twice: once they are exhausted the record starts a new
+         * epoch, or is retired if generations are not widened, so stale references never validate.
          */
         void Release()
         {
             archetype = InvalidIndex;
             row = InvalidIndex;
-            version++;
 
-            Index index = GetIndex();
-            if (index == last - 1)
+            // InvalidIndex is never handed out, a retired record keeps it so no reference matches
+            if (++version == InvalidIndex)
+            {
+#if HYPERION_RECORD_WIDE_GENERATION
+                Index& epoch = records.Epoch(index);
+                if (epoch == InvalidIndex - 1)
+                {
+                    retired++;
+                    return;
+                }
+                epoch++;
+                version = 0;
+#else
+                retired++;
+                return;
+#endif
+            }
+
+#if HYPERION_RECORD_REUSE_FIFO
+            if (freeTail != InvalidIndex)
             {
-                last--;
-                recycleBin.Clear(index);
+                records[freeTail].row = index;
             }
             else
             {
-                recycleBin.Set(index);
+                freeHead = index;
             }
+            freeTail = index;
+#else
+            row = freeHead;
+            freeHead = index;
+            if (freeTail == InvalidIndex) freeTail = index;
+#endif
         }
     };
 }
@@ -11,15 +11,68 @@ namespace Hyperion::ECS
     {
     private:
         friend class World;
+        friend class FrustumCulling;
+        template <typename Rel>
+        friend class RelationIndex;
 
         Index recordIndex = InvalidIndex;
         Index version = InvalidIndex;
+#if HYPERION_RECORD_WIDE_GENERATION
+        Index epoch = InvalidIndex;
+
+        /**
+         * @brief Private constructor for creating an EntityReference from an EntityRecord.
+         * @param record The EntityRecord to reference.
+         */
+        EntityReference(const EntityRecord& record) :
+            recordIndex(record.GetIndex()), version(record.version), epoch(EntityRecord::records.Epoch(record.GetIndex())) {}
+#else
 
         /**
          * @brief Private constructor for creating an EntityReference from an EntityRecord.
          * @param record The EntityRecord to reference.
          */
         EntityReference(const EntityRecord& record) : recordIndex(record.GetIndex()), version(record.version) {}
+#endif
+
+        /**
+         * @brief Check that the reference designates the entity currently held by its record.
+         * @param record The record at recordIndex.
+         */
+        bool Matches(const EntityRecord& record) const
+        {
+#if HYPERION_RECORD_WIDE_GENERATION
+            // Stale references almost always fail on the version, without touching the cold epoch
+            return version == record.version && epoch == EntityRecord::records.Epoch(recordIndex);
+#else
+            return version == record.version;
+#endif
+        }
+
+        /**
+         * @brief Move the referenced entity to the archetype produced by a binary identifier transformation.
+         * @param transform Function mapping the current binary identifier to the target one.
+         * @return true if the entity is valid and was migrated (or already matched), false otherwise or if the target archetype cannot grow.
+         */
+        bool Migrate(Component::BinaryId(*transform)(Component::BinaryId))
+        {
+            if (recordIndex == InvalidIndex) return false;
+
+            const EntityRecord& record = EntityRecord::records[recordIndex];
+            if (!Matches(record)) return false;
+
+            const Index sourceIndex = record.archetype;
+            const Index sourceRow = record.row;
+            const Component::BinaryId targetId = transform(ArchetypeManager::managers[sourceIndex].id);
+
+            if (targetId != ArchetypeManager::managers[sourceIndex].id)
+            {
+                // Find may grow the manager list, so resolve both archetypes afterwards
+                const size_t targetIndex = ArchetypeManager::Find(targetId);
+                if (!ArchetypeManager::managers[targetIndex].MoveEntity(&ArchetypeManager::managers[sourceIndex], sourceRow)) return false;
+            }
+            return true;
+        }
 
     public:
         /**
@@ -27,6 +80,11 @@ namespace Hyperion::ECS
          */
         EntityReference() = default;
 
+        /**
+         * @brief Compare two references, equal when they designate the same entity.
+         */
+        bool operator==(const EntityReference& other) const = default;
+
         /**
          * @brief Access the entity's components and execute a lambda function.
          * @tparam Lambda The lambda function to execute.
@@ -40,13 +98,17 @@ namespace Hyperion::ECS
             if (recordIndex != InvalidIndex)
             {
                 const EntityRecord& record = EntityRecord::records[recordIndex];
-                if (version == record.version)
+                if (Matches(record))
                 {
                     ArchetypeManager& archetype = ArchetypeManager::managers[record.archetype];
                     using LambdaTraits = LambdaUtil<decltype(&Lambda::operator())>;
                     LambdaTraits::CallWithTypes([lambda, &archetype, &record]<typename ...Components>()
                     {
-                        lambda(archetype.GetComponent<Components>(record.row)...);
+                        [lambda](ArchetypeManager::Column<Components>... columns)
+                        {
+                            lambda(columns.Get()...);
+                            (columns.Store(), ...);
+                        }(ArchetypeManager::Column<Components>(archetype, record.row)...);
                     });
                     status = true;
                 }
@@ -54,6 +116,71 @@ namespace Hyperion::ECS
             return status;
         }
 
+        /**
+         * @brief Write a component of the referenced entity and report it to the OnSet hook.
+         * Writes to sparse components are not reported, hooks do not cover them.
+         * @tparam T The component type.
+         * @param value The new component value.
+         * @return true if the entity is accessible and holds the component, false otherwise.
+         */
+        template <typename T>
+        bool Set(const T& value)
+        {
+            if (recordIndex == InvalidIndex) return false;
+
+            const EntityRecord& record = EntityRecord::records[recordIndex];
+            if (!Matches(record)) return false;
+
+            if constexpr (SparseComponent<T>)
+            {
+                T* component = SparseSet<T>::Find(recordIndex);
+                if (!component) return false;
+
+                *component = value;
+            }
+            else
+            {
+                T* component = ArchetypeManager::managers[record.archetype].GetComponent<T>(record.row);
+                if (!component) return false;
+
+                *component = value;
+                ComponentHooks::Record(ComponentHooks::Set, Component::IdBinary<T>, record);
+            }
+            return true;
+        }
+
+        /**
+         * @brief Add components to the referenced entity, migrating it to the matching archetype.
+         * Sparse components are added to their SparseSet, without migrating the entity.
+         * @tparam Ts The component types to add.
+         * @return true if the entity is accessible and now holds the components, false otherwise.
+         */
+        template <typename... Ts>
+        bool AddComponents()
+        {
+            using Helper = ArchetypeManager::Helper<Ts...>;
+            if (!Migrate(Helper::AddTo)) return false;
+
+            Helper::AddSparse(recordIndex);
+            return true;
+        }
+
+        /**
+         * @brief Remove components from the referenced entity, migrating it to the matching archetype.
+         * Sparse components are removed from their SparseSet, without migrating the entity.
+         * @tparam Ts The component types to remove.
+         * @return true if the entity is accessible and no longer holds the components, false otherwise.
+         */
+        template <typename... Ts>
+        bool RemoveComponents()
+        {
+            using Helper = ArchetypeManager::Helper<Ts...>;
+            if (!Migrate(Helper::RemoveFrom)) return false;
+
+            Helper::RemoveSparse(recordIndex);
+            return true;
+        }
+
         /**
          * @brief Destroy the referenced entity.
          */
@@ -62,8 +189,9 @@ namespace Hyperion::ECS
             if (recordIndex != InvalidIndex)
             {
                 const EntityRecord& record = EntityRecord::records[recordIndex];
+                const bool current = Matches(record);
                 recordIndex = InvalidIndex;
-                if (version == record.version)
+                if (current)
                 {
                     ArchetypeManager::managers[record.archetype].RemoveRow(record.row);
                 }
@@ -0,0 +1,199 @@
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include "World.hpp"
+#include "../Math/Frustum.hpp"
+#include "../Utils/HierarchicalBitset.hpp"
+
+namespace Hyperion::ECS
+{
+    /**
+     * @brief World-space bounding sphere of an entity, kept up to date by the transform code.
+     */
+    struct BoundingSphere
+    {
+        Vec3 center;    /**< Center of the sphere. */
+        Fxp radius;     /**< Radius of the sphere. */
+    };
+
+    /**
+     * @brief Per-entity culling data, carried from one frame to the next.
+     */
+    struct CullingState
+    {
+        static constexpr uint8_t AllPlanes = (1 << Frustum::PlaneCount) - 1;
+
+        EntityReference parent;         /**< Entity whose bounding sphere encloses this one, if any. */
+        uint8_t planeMask = AllPlanes;  /**< Planes the sphere straddled, bit i standing for plane i. */
+        uint8_t lastPlane = 0;          /**< Plane that rejected the sphere last time, tested first. */
+        uint8_t frame = 0;              /**< Frame stamp of the last test. */
+        bool visible = false;           /**< Result of the last test. */
+    };
+
+    /**
+     * @brief Culls every entity with a BoundingSphere and a CullingState against a frustum.
+     *
+     * Each frame the system walks the bounding sphere and state columns and writes the result
+     * to a visibility bitset indexed by entity record, which stays valid until the next Cull.
+     * Two kinds of coherence keep the number of plane tests low:
+     * - the plane that rejected a sphere is tested first on the next frame, so objects staying
+     *   out of view usually cost a single plane test;
+     * - children only test the planes their parent straddles, so when a parent is fully inside
+     *   the frustum its children are accepted without any test, and when it is rejected so are they.
+     * Parents are culled on demand before their children, whatever the archetype order.
+     */
+    class FrustumCulling : World::EntityIterator
+    {
+        HierarchicalBitset visibility;
+        uint8_t frame = 0;
+        size_t planeTests = 0;
+        size_t culledEntities = 0;
+
+        /**
+         * @brief Test a sphere against the planes of a mask, starting with the last rejecting plane.
+         * @param frustum The view frustum.
+         * @param sphere The bounding sphere.
+         * @param state The culling state, updated with the result.
+         * @param testMask The planes to test.
+         */
+        void Test(const Frustum& frustum, const BoundingSphere& sphere, CullingState& state, uint8_t testMask)
+        {
+            state.frame = frame;
+            state.planeMask = 0;
+
+            const Fxp negativeRadius = -sphere.radius;
+
+            // Coherence: retry the plane that rejected the sphere last time first
+            if (testMask & (1 << state.lastPlane))
+            {
+                planeTests++;
+                const Fxp distance = frustum.GetPlane(state.lastPlane).Distance(sphere.center);
+                if (distance < negativeRadius)
+                {
+                    state.visible = false;
+                    return;
+                }
+                if (distance < sphere.radius) state.planeMask |= (1 << state.lastPlane);
+                testMask &= ~(1 << state.lastPlane);
+            }
+
+            for (uint8_t i = 0; testMask; i++, testMask >>= 1)
+            {
+                if (!(testMask & 1)) continue;
+
+                planeTests++;
+                const Fxp distance = frustum.GetPlane(i).Distance(sphere.center);
+                if (distance < negativeRadius)
+                {
+                    state.lastPlane = i;
+                    state.visible = false;
+                    return;
+                }
+                if (distance < sphere.radius) state.planeMask |= (1 << i);
+            }
+
+            state.visible = true;
+        }
+
+        /**
+         * @brief Cull an entity, culling its parent chain first when needed.
+         * @param frustum The view frustum.
+         * @param sphere The bounding sphere of the entity.
+         * @param state The culling state of the entity.
+         */
+        void Resolve(const Frustum& frustum, const BoundingSphere& sphere, CullingState& state)
+        {
+            if (state.frame == frame) return;
+
+            // Stamp first, so a parent cycle ends instead of recursing forever
+            state.frame = frame;
+
+            uint8_t testMask = CullingState::AllPlanes;
+            bool parentVisible = true;
+
+            state.parent.Access([this, &frustum, &testMask, &parentVisible](BoundingSphere* parentSphere, CullingState* parentState)
+            {
+                if (!parentSphere || !parentState) return;
+
+                Resolve(frustum, *parentSphere, *parentState);
+                testMask = parentState->planeMask;
+                parentVisible = parentState->visible;
+            });
+
+            if (parentVisible)
+            {
+                Test(frustum, sphere, state, testMask);
+            }
+            else
+            {
+                state.visible = false;
+            }
+        }
+
+    public:
+        /**
+         * @brief Cull all entities against a frustum.
+         * @param frustum The view frustum.
+         */
+        void Cull(const Frustum& frustum)
+        {
+            // Zero is the stamp of states never culled, skip it so they are always tested
+            if (++frame == 0) frame = 1;
+            planeTests = 0;
+            culledEntities = 0;
+
+            Iterate([this, &frustum](BoundingSphere* sphere, CullingState* state)
+            {
+                Resolve(frustum, *sphere, *state);
+
+                const EntityReference entity = GetCurrentEntity();
+                if (entity.recordIndex >= visibility.GetCapacity())
+                {
+                    const size_t capacity = visibility.GetCapacity();
+                    visibility.Resize((entity.recordIndex < capacity * 2) ? capacity * 2 : entity.recordIndex + 1);
+                }
+
+                // Visibility rarely changes between frames, only touch the bitset (and its summary) when it does
+                if (visibility.Get(entity.recordIndex) != state->visible)
+                {
+                    if (state->visible)
+                    {
+                        visibility.Set(entity.recordIndex);
+                    }
+                    else
+                    {
+                        visibility.Clear(entity.recordIndex);
+                    }
+                }
+                culledEntities++;
+            });
+        }
+
+        /**
+         * @brief Check whether an entity was visible during the last Cull.
+         * @param entity The entity, expected to be alive since the last Cull.
+         * @return true if the entity is visible, false otherwise.
+         */
+        bool IsVisible(const EntityReference& entity) const
+        {
+            return visibility.Get(entity.recordIndex);
+        }
+
+        /**
+         * @brief Get the visibility bitset of the last Cull, indexed by entity record.
+         */
+        const HierarchicalBitset& GetVisibility() const { return visibility; }
+
+        /**
+         * @brief Get the number of plane tests performed by the last Cull.
+         */
+        size_t PlaneTests() const { return planeTests; }
+
+        /**
+         * @brief Get the number of entities processed by the last Cull.
+         */
+        size_t CulledEntities() const { return culledEntities; }
+    };
+}
@@ -0,0 +1,148 @@
+#pragma once
+
+#include <stddef.h>
+
+#include "Archetype.hpp"
+#include "../Utils/std/utils.h"
+
+namespace Hyperion::ECS
+{
+    /**
+     * @brief Owning group: keeps the chosen components of every matching archetype in one packed store.
+     *
+     * Once created, each archetype holding all of Ts stores its columns for them as adjacent
+     * segments of a GroupStorage, including archetypes created later. Entities are still
+     * created, migrated and iterated as usual; Each and EachSpan walk the segments in order,
+     * one dense span per archetype, without going through archetype lookups.
+     * A component can be owned by a single group. Growing an archetype of the group costs a
+     * shift of the segments after it, so groups suit hot joins over mostly stable entities.
+     * The shift moves the owned columns of every archetype of the group: while an Iterate, Each or
+     * EachSpan runs over any of them, entities must not be created in nor moved into an archetype
+     * of the group, just as an iterated archetype must not grow.
+     * @tparam Ts The owned component types, trivially copyable.
+     */
+    template <typename... Ts>
+    class OwningGroup
+    {
+        static_assert(sizeof...(Ts) > 0 && sizeof...(Ts) <= GroupStorage::MaxOwned, "Unsupported number of owned components.");
+        static_assert((std::is_trivially_copyable_v<Ts> && ...), "Owned components must be trivially copyable.");
+        static_assert(((!SplitComponent<Ts> && !SparseComponent<Ts>) && ...), "Owned components must be stored as whole structs in archetypes.");
+
+        static inline GroupStorage storage;
+        static inline bool created = false;
+
+        /**
+         * @brief Default construct the new elements of a grown segment.
+         */
+        template <typename T>
+        static void Construct(void* elements, size_t count)
+        {
+            T* typed = static_cast<T*>(elements);
+            for (size_t i = 0; i < count; i++)
+            {
+                new (&typed[i]) T{};
+            }
+        }
+
+        /**
+         * @brief Position of an owned component in Ts.
+         */
+        template <typename T>
+        static constexpr size_t IndexOf()
+        {
+            size_t index = 0;
+            size_t i = 0;
+            ((std::is_same_v<T, Ts> ? (index = i++) : i++), ...);
+            return index;
+        }
+
+        template <typename T>
+        static constexpr bool Owns = (std::is_same_v<T, Ts> || ...);
+
+    public:
+        /**
+         * @brief Create the group, moving the owned columns of existing archetypes into its storage.
+         * @return true if the group exists, false if one of its components is already owned by another group.
+         */
+        static bool Create()
+        {
+            if (created) return true;
+
+            storage.owned = (ArchetypeManager::SignatureOf<Ts>() | ...);
+            storage.ownedCount = sizeof...(Ts);
+            size_t c = 0;
+            ((storage.componentIds[c] = Component::Id<Ts>, storage.elementSizes[c] = sizeof(Ts), storage.construct[c] = &Construct<Ts>, c++), ...);
+
+            if (!GroupStorage::Register(&storage)) return false;
+            created = true;
+
+            const size_t group = GroupStorage::groupCount - 1;
+            for (size_t i = 0; i < ArchetypeManager::managers.size(); i++)
+            {
+                ArchetypeManager::managers[i].JoinGroup(group);
+            }
+            return true;
+        }
+
+        /**
+         * @brief Get the number of entities in the group.
+         */
+        static size_t Size()
+        {
+            size_t count = 0;
+            for (size_t s = 0; s < storage.segmentCount; s++)
+            {
+                count += ArchetypeManager::managers[storage.segments[s].archetype].size;
+            }
+            return count;
+        }
+
+        /**
+         * @brief Execute a lambda function for each entity of the group.
+         * The lambda must not create, destroy or migrate entities.
+         * @tparam Lambda The lambda function to execute, taking pointers to owned components in any order.
+         * @param lambda The lambda function to execute.
+         */
+        template <typename Lambda>
+        static void Each(Lambda lambda)
+        {
+            using LambdaTraits = LambdaUtil<decltype(&Lambda::operator())>;
+            LambdaTraits::CallWithTypes([&lambda]<typename... Components>()
+            {
+                static_assert((Owns<Components> && ...), "Each only provides components owned by the group.");
+
+                for (size_t s = 0; s < storage.segmentCount; s++)
+                {
+                    const GroupStorage::Segment& segment = storage.segments[s];
+                    const Index rows = ArchetypeManager::managers[segment.archetype].size;
+                    [&lambda, rows](Components*... arrays)
+                    {
+                        for (Index row = 0; row < rows; row++)
+                        {
+                            lambda(&arrays[row]...);
+                        }
+                    }(reinterpret_cast<Components*>(storage.columns[IndexOf<Components>()]) + segment.offset...);
+                }
+            });
+        }
+
+        /**
+         * @brief Execute a function once per archetype of the group, with its dense arrays.
+         * The function must not create, destroy or migrate entities.
+         * @param function Function taking the number of rows, then one array per owned component in Ts order.
+         */
+        template <typename Function>
+        static void EachSpan(Function function)
+        {
+            for (size_t s = 0; s < storage.segmentCount; s++)
+            {
+                const GroupStorage::Segment& segment = storage.segments[s];
+                const size_t rows = ArchetypeManager::managers[segment.archetype].size;
+                if (rows)
+                {
+                    function(rows, reinterpret_cast<Ts*>(storage.columns[IndexOf<Ts>()]) + segment.offset...);
+                }
+            }
+        }
+    };
+}
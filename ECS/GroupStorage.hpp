@@ -0,0 +1,207 @@
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "EntityRecord.hpp"
+#include "Component.hpp"
+
+namespace Hyperion::ECS
+{
+    /**
+     * @brief Shared packed store of the components owned by an OwningGroup.
+     *
+     * Every archetype holding all the owned components keeps its columns for them as a segment
+     * of one array per component, instead of separate allocations. Segments follow each other in
+     * archetype join order, so a join over the owned components walks adjacent dense spans.
+     * Growing a segment shifts the ones after it, which is amortized by the geometric growth of
+     * archetypes, and moves the columns of their archetypes. Owned components must be trivially
+     * copyable so they can be shifted as bytes.
+     */
+    class GroupStorage
+    {
+        friend class ArchetypeManager;
+        template <typename... Ts>
+        friend class OwningGroup;
+
+        static constexpr size_t MaxGroups = 8;
+        static constexpr size_t MaxOwned = 8;
+
+        /**
+         * @brief Columns of one participating archetype.
+         */
+        struct Segment
+        {
+            Index archetype;
+            size_t offset;                  /**< First element of the segment in each column. */
+            size_t capacity;                /**< Elements reserved, the archetype capacity. */
+            void** slots[MaxOwned];         /**< Column pointers of the archetype to keep pointing at the segment. */
+        };
+
+        static inline GroupStorage* groups[MaxGroups] = {};
+        static inline size_t groupCount = 0;
+        static inline Component::BinaryId ownedByGroups = 0;
+
+        Component::BinaryId owned = 0;
+        size_t ownedCount = 0;
+        size_t componentIds[MaxOwned] = {};
+        size_t elementSizes[MaxOwned] = {};
+        void (*construct[MaxOwned])(void* elements, size_t count) = {};
+
+        uint8_t* columns[MaxOwned] = {};
+        size_t capacity = 0;
+        size_t used = 0;
+
+        Segment* segments = nullptr;
+        size_t segmentCount = 0;
+        size_t segmentCapacity = 0;
+
+        /**
+         * @brief Point the columns of every participating archetype at their segment.
+         */
+        void Rewire()
+        {
+            for (size_t s = 0; s < segmentCount; s++)
+            {
+                for (size_t c = 0; c < ownedCount; c++)
+                {
+                    *segments[s].slots[c] = columns[c] + (segments[s].offset * elementSizes[c]);
+                }
+            }
+        }
+
+        /**
+         * @brief Make room for a number of elements in every column.
+         * @return true if the columns hold at least the requested elements.
+         */
+        bool Reserve(size_t elements)
+        {
+            if (elements <= capacity) return true;
+
+            size_t newCapacity = (capacity == 0) ? 16 : capacity;
+            while (newCapacity < elements)
+            {
+                newCapacity = (newCapacity * 2) - (newCapacity / 2);
+            }
+
+            for (size_t c = 0; c < ownedCount; c++)
+            {
+                uint8_t* newColumn = static_cast<uint8_t*>(realloc(columns[c], newCapacity * elementSizes[c]));
+                if (!newColumn)
+                {
+                    // Columns already grown keep their larger size, the capacity stays the smallest
+                    Rewire();
+                    return false;
+                }
+                columns[c] = newColumn;
+            }
+
+            capacity = newCapacity;
+            Rewire();
+            return true;
+        }
+
+        /**
+         * @brief Find the segment of an archetype.
+         * @return The segment, or nullptr if the archetype does not participate.
+         */
+        Segment* FindSegment(Index archetype)
+        {
+            for (size_t s = 0; s < segmentCount; s++)
+            {
+                if (segments[s].archetype == archetype) return &segments[s];
+            }
+            return nullptr;
+        }
+
+        /**
+         * @brief Add an archetype as the last segment, moving its current columns into the store.
+         * @param archetype The index of the archetype.
+         * @param archetypeCapacity The number of rows allocated in its columns.
+         * @param slots The column pointers of the archetype, one per owned component in group order.
+         * @return true if the archetype joined.
+         */
+        bool Join(Index archetype, size_t archetypeCapacity, void** const* slots)
+        {
+            if (segmentCount >= segmentCapacity)
+            {
+                const size_t newCapacity = (segmentCapacity == 0) ? 8 : (segmentCapacity * 2) - (segmentCapacity / 2);
+                Segment* newSegments = static_cast<Segment*>(realloc(segments, sizeof(Segment) * newCapacity));
+                if (!newSegments) return false;
+                segments = newSegments;
+                segmentCapacity = newCapacity;
+            }
+
+            if (!Reserve(used + archetypeCapacity)) return false;
+
+            Segment& segment = segments[segmentCount++];
+            segment.archetype = archetype;
+            segment.offset = used;
+            segment.capacity = archetypeCapacity;
+
+            for (size_t c = 0; c < ownedCount; c++)
+            {
+                segment.slots[c] = slots[c];
+                if (*slots[c])
+                {
+                    memcpy(columns[c] + (used * elementSizes[c]), *slots[c], archetypeCapacity * elementSizes[c]);
+                    Component::DeleteArray(componentIds[c], *slots[c]);
+                }
+            }
+
+            used += archetypeCapacity;
+            Rewire();
+            return true;
+        }
+
+        /**
+         * @brief Grow the segment of an archetype, shifting the following segments.
+         * @param archetype The index of the archetype.
+         * @param newCapacity The new number of rows of the archetype.
+         * @return true if the segment grew.
+         */
+        bool Grow(Index archetype, size_t newCapacity)
+        {
+            Segment* segment = FindSegment(archetype);
+            if (!segment || newCapacity <= segment->capacity) return segment != nullptr;
+
+            const size_t delta = newCapacity - segment->capacity;
+            const size_t segmentIndex = segment - segments;
+            if (!Reserve(used + delta)) return false;
+            segment = &segments[segmentIndex];
+
+            const size_t tail = segment->offset + segment->capacity;
+            for (size_t c = 0; c < ownedCount; c++)
+            {
+                const size_t elementSize = elementSizes[c];
+                memmove(columns[c] + ((tail + delta) * elementSize), columns[c] + (tail * elementSize), (used - tail) * elementSize);
+                construct[c](columns[c] + (tail * elementSize), delta);
+            }
+
+            for (size_t s = segmentIndex + 1; s < segmentCount; s++)
+            {
+                segments[s].offset += delta;
+            }
+            segment->capacity = newCapacity;
+            used += delta;
+
+            Rewire();
+            return true;
+        }
+
+        /**
+         * @brief Register a group, its owned components must not be owned by another group.
+         * @return true if registered, false if MaxGroups groups exist or a component is owned already.
+         */
+        static bool Register(GroupStorage* group)
+        {
+            if (groupCount >= MaxGroups || (ownedByGroups & group->owned)) return false;
+
+            groups[groupCount++] = group;
+            ownedByGroups |= group->owned;
+            return true;
+        }
+    };
+}
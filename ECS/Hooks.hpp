@@ -0,0 +1,206 @@
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../Utils/EventManager.hpp"
+#include "EntityRecord.hpp"
+#include "Component.hpp"
+
+namespace Hyperion::ECS
+{
+    class EntityReference;
+
+    /**
+     * @brief Rows of one archetype affected by a lifecycle event, handed to a component hook.
+     * @tparam T The component type.
+     */
+    template <typename T>
+    struct ComponentSpan
+    {
+        T* column;                          /**< Component column, or the saved values for removals. */
+        const uint32_t* rows;               /**< Affected rows within column. */
+        const EntityReference* entities;    /**< Affected entities, removed ones are no longer valid but still identify them. */
+        size_t count;                       /**< Number of affected rows. */
+
+        /**
+         * @brief Get the component of the i-th affected row.
+         */
+        T& operator[](size_t i) const { return column[rows[i]]; }
+    };
+
+    /**
+     * @brief Component hook, called once per archetype with all the rows affected since the last flush.
+     */
+    template <typename T>
+    using ComponentHook = void (*)(const ComponentSpan<T>& span);
+
+    /**
+     * @brief Empty event queued on EventManager to deliver pending hooks, see World::DeliverHooksWithEvents.
+     */
+    struct ComponentHooksPending {};
+
+    /**
+     * @brief Records component lifecycle events for the hooks registered through World.
+     *
+     * Archetype operations only append the affected records here (and a copy of the values
+     * for removals), hooks run later, when pending events are flushed.
+     */
+    class ComponentHooks
+    {
+        friend class ArchetypeManager;
+        friend class EntityReference;
+        friend struct World;
+
+        enum Kind
+        {
+            Add,
+            Set,
+            Remove,
+            KindCount
+        };
+
+        /**
+         * @brief An affected record, with the archetype it was in and its version at that time.
+         */
+        struct Pending
+        {
+            Index archetype;
+            Index record;
+            Index version;
+        };
+
+        /**
+         * @brief Growable list of pending events of one kind.
+         */
+        struct Queue
+        {
+            Pending* entries = nullptr;
+            size_t size = 0;
+            size_t capacity = 0;
+
+            bool Push(const Pending& pending)
+            {
+                if (size >= capacity)
+                {
+                    const size_t newCapacity = (capacity == 0) ? 16 : (capacity * 2) - (capacity / 2);
+                    Pending* newEntries = static_cast<Pending*>(realloc(entries, sizeof(Pending) * newCapacity));
+                    if (!newEntries) return false;
+                    entries = newEntries;
+                    capacity = newCapacity;
+                }
+                entries[size++] = pending;
+                return true;
+            }
+        };
+
+        /**
+         * @brief Hooks and pending events of one component type.
+         */
+        struct Entry
+        {
+            void* hooks[KindCount] = {};            /**< Type-erased ComponentHook<T>, one per kind. */
+            Queue queues[KindCount];                /**< Events recorded since the last flush. */
+            Queue delivered[KindCount];             /**< Events being delivered, swapped with queues on flush. */
+            uint8_t* removedValues = nullptr;       /**< Values of removed components, one per Remove entry. */
+            uint8_t* deliveredValues = nullptr;
+            size_t valueCapacity = 0;
+            size_t deliveredValueCapacity = 0;
+            size_t valueSize = 0;
+            void (*dispatch)(size_t componentId) = nullptr;
+
+            /**
+             * @brief Move the recorded events of a kind to the delivered buffers, recycling the previous ones.
+             */
+            Queue& Swap(Kind kind)
+            {
+                Queue previous = delivered[kind];
+                delivered[kind] = queues[kind];
+                queues[kind] = previous;
+                queues[kind].size = 0;
+
+                if (kind == Remove)
+                {
+                    uint8_t* values = deliveredValues;
+                    deliveredValues = removedValues;
+                    removedValues = values;
+
+                    const size_t capacity = deliveredValueCapacity;
+                    deliveredValueCapacity = valueCapacity;
+                    valueCapacity = capacity;
+                }
+                return delivered[kind];
+            }
+        };
+
+        static inline Entry* entries[Component::MaxComponentTypes] = {};
+        static inline Component::BinaryId masks[KindCount] = {};
+        static inline bool deliverWithEvents = false;
+        static inline bool flushQueued = false;
+        static inline bool flushing = false;
+
+        /**
+         * @brief Queue a flush on EventManager if delivery through events is enabled.
+         */
+        static void RequestFlush()
+        {
+            if (deliverWithEvents && !flushQueued)
+            {
+                flushQueued = EventManager::QueueEvent<ComponentHooksPending>();
+            }
+        }
+
+        /**
+         * @brief Record an event of one kind for each hooked component of a set.
+         * @param kind The event kind.
+         * @param ids The components affected.
+         * @param record The affected entity record.
+         */
+        static void Record(Kind kind, Component::BinaryId ids, const EntityRecord& record)
+        {
+            ids &= masks[kind];
+            if (!ids) return;
+
+            const Pending pending = { record.archetype, record.GetIndex(), record.version };
+            size_t componentId = 0;
+            do
+            {
+                if (1 & ids) entries[componentId]->queues[kind].Push(pending);
+                componentId++;
+            } while (ids >>= 1);
+
+            RequestFlush();
+        }
+
+        /**
+         * @brief Record the removal of a component, saving its value before the row is overwritten.
+         * @param componentId The removed component.
+         * @param record The affected entity record, still located at its row.
+         * @param column The component column of the record's archetype.
+         */
+        static void RecordRemoval(size_t componentId, const EntityRecord& record, const void* column)
+        {
+            Entry& entry = *entries[componentId];
+            Queue& queue = entry.queues[Remove];
+            const size_t position = queue.size;
+
+            if (position >= entry.valueCapacity)
+            {
+                const size_t newCapacity = (entry.valueCapacity == 0) ? 16 : (entry.valueCapacity * 2) - (entry.valueCapacity / 2);
+                uint8_t* newValues = static_cast<uint8_t*>(realloc(entry.removedValues, entry.valueSize * newCapacity));
+                if (!newValues) return;
+                entry.removedValues = newValues;
+                entry.valueCapacity = newCapacity;
+            }
+
+            if (!queue.Push({ record.archetype, record.GetIndex(), record.version })) return;
+
+            memcpy(entry.removedValues + (position * entry.valueSize),
+                static_cast<const uint8_t*>(column) + (record.row * entry.valueSize), entry.valueSize);
+
+            RequestFlush();
+        }
+    };
+}
@@ -0,0 +1,256 @@
+#pragma once
+
+#include <stddef.h>
+
+#include "../Utils/std/utils.h"
+
+namespace Hyperion::ECS
+{
+    /**
+     * @brief Extracts the owning class and value type of a data member pointer.
+     * @tparam T The member pointer type.
+     */
+    template <typename T>
+    struct MemberTraits;
+
+    template <typename C, typename T>
+    struct MemberTraits<T C::*>
+    {
+        using Class = C;
+        using Type = T;
+    };
+
+    /**
+     * @brief Single field of a split component, used as a query type in lambdas.
+     *
+     * Requesting `Field<&Position::x>*` instead of `Position*` walks only the array holding
+     * the x values of each archetype. Arrays of fields are stored as arrays of this wrapper.
+     * @tparam MemberPointer Pointer to the data member.
+     */
+    template <auto MemberPointer>
+    struct Field
+    {
+        using Component = typename MemberTraits<decltype(MemberPointer)>::Class; /**< Owning component type. */
+        using Type = typename MemberTraits<decltype(MemberPointer)>::Type;       /**< Type of the field. */
+        static constexpr auto Member = MemberPointer;                            /**< Pointer to the data member. */
+
+        Type value;
+    };
+
+    /**
+     * @brief List of data members stored as separate arrays.
+     * @tparam Members Pointers to the data members of a component.
+     */
+    template <auto... Members>
+    struct Fields
+    {
+        using Layout = Fields<Members...>;
+        static constexpr size_t FieldCount = sizeof...(Members);
+    };
+
+    /**
+     * @brief Layout trait, components are stored as whole structs unless specialized.
+     *
+     * To store a component field by field (structure of arrays), specialize it with the list
+     * of its data members, e.g.
+     * `template <> struct Hyperion::ECS::SplitLayout<Position> : Fields<&Position::x, &Position::y> {};`.
+     * Members left out of the list are not stored, they read as their default value.
+     * @tparam T The component type.
+     */
+    template <typename T>
+    struct SplitLayout
+    {
+    };
+
+    /**
+     * @brief A component whose layout trait lists its fields.
+     * @tparam T The component type.
+     */
+    template <typename T>
+    concept SplitComponent = requires { SplitLayout<T>::FieldCount; };
+
+    /**
+     * @brief Matches Field<Member> query types.
+     * @tparam T The query type.
+     */
+    template <typename T>
+    struct IsFieldImplementation : std::false_type {};
+
+    template <auto Member>
+    struct IsFieldImplementation<Field<Member>> : std::true_type {};
+
+    template <typename T>
+    concept FieldType = IsFieldImplementation<T>::value;
+
+    /**
+     * @brief Resolves the component owning a query type, the type itself unless it is a Field.
+     * @tparam T The query type.
+     */
+    template <typename T>
+    struct ComponentOfImplementation
+    {
+        using Type = T;
+    };
+
+    template <FieldType T>
+    struct ComponentOfImplementation<T>
+    {
+        using Type = typename T::Component;
+    };
+
+    template <typename T>
+    using ComponentOf = typename ComponentOfImplementation<T>::Type;
+
+    /**
+     * @brief Storage operations of a split component column.
+     *
+     * The column is an array of pointers, one per field, each pointing to an array of
+     * Field<Member> holding that member for every row of the archetype.
+     * @tparam T The component type.
+     * @tparam Layout The fields of the component.
+     */
+    template <typename T, typename Layout = typename SplitLayout<T>::Layout>
+    struct SplitStorage;
+
+    template <typename T, auto... Members>
+    struct SplitStorage<T, Fields<Members...>>
+    {
+        static_assert(std::is_trivially_copyable_v<T>, "Split components must be trivially copyable.");
+        static_assert(((sizeof(Field<Members>) == sizeof(typename Field<Members>::Type)) && ...),
+            "Field wrappers must match the size of their member.");
+
+        static constexpr size_t FieldCount = sizeof...(Members);
+
+        /**
+         * @brief Whether the fields fill the whole struct, so gathering them leaves nothing to initialize.
+         */
+        static constexpr bool Complete = (sizeof(typename Field<Members>::Type) + ...) == sizeof(T);
+
+        /**
+         * @brief Get the position of a member within the layout.
+         * @tparam Member The data member pointer.
+         */
+        template <auto Member>
+        static constexpr size_t IndexOf = []()
+        {
+            constexpr bool matches[] = { std::is_same_v<Field<Member>, Field<Members>>... };
+            size_t index = 0;
+            while (index < FieldCount && !matches[index]) index++;
+            return index;
+        }();
+
+        /**
+         * @brief Get the array holding one member for every row.
+         * @tparam Member The data member pointer.
+         * @param column The split column.
+         * @return A pointer to the field array.
+         */
+        template <auto Member>
+        static Field<Member>* FieldArray(void* column)
+        {
+            static_assert(IndexOf<Member> < FieldCount, "Member is not part of the split layout.");
+            return static_cast<Field<Member>*>(static_cast<void**>(column)[IndexOf<Member>]);
+        }
+
+        /**
+         * @brief Copy the fields of a row into a whole struct.
+         * @param column The split column.
+         * @param row The row index.
+         * @param component The destination struct.
+         */
+        static void Gather(void* column, size_t row, T& component)
+        {
+            ((component.*Members = FieldArray<Members>(column)[row].value), ...);
+        }
+
+        /**
+         * @brief Copy a whole struct into the fields of a row.
+         * @param column The split column.
+         * @param row The row index.
+         * @param component The source struct.
+         */
+        static void Scatter(void* column, size_t row, const T& component)
+        {
+            ((FieldArray<Members>(column)[row].value = component.*Members), ...);
+        }
+
+        /**
+         * @brief Deletes a split column and all of its field arrays.
+         * @param column The split column.
+         */
+        static void DeleteArray(void* column)
+        {
+            if (column)
+            {
+                (delete[] FieldArray<Members>(column), ...);
+                delete[] static_cast<void**>(column);
+            }
+        }
+
+        /**
+         * @brief Moves a row from one split column to another.
+         * @param dstColumn The destination column.
+         * @param dstPos The position in the destination column.
+         * @param srcColumn The source column.
+         * @param srcPos The position in the source column.
+         */
+        static void MoveElement(void* dstColumn, size_t dstPos, void* srcColumn, size_t srcPos)
+        {
+            static const T defaults{};
+            ((FieldArray<Members>(dstColumn)[dstPos] = FieldArray<Members>(srcColumn)[srcPos]), ...);
+            Scatter(srcColumn, srcPos, defaults);
+        }
+
+        /**
+         * @brief Resizes every field array of a split column.
+         * @param ptrToColumn Pointer to the column to be resized, allocated on first use.
+         * @param newSize The new number of rows.
+         * @param moveCount The number of rows to keep.
+         * @return true If the column was resized successfully.
+         * @return false If resizing failed.
+         */
+        static bool ResizeArray(void** ptrToColumn, size_t newSize, size_t moveCount)
+        {
+            if (!*ptrToColumn)
+            {
+                void** fields = new void* [FieldCount]();
+                if (!fields)
+                {
+                    return false;
+                }
+                *ptrToColumn = fields;
+            }
+
+            return (ResizeField<Members>(*ptrToColumn, newSize, moveCount) && ...);
+        }
+
+    private:
+        template <auto Member>
+        static bool ResizeField(void* column, size_t newSize, size_t moveCount)
+        {
+            static const T defaults{};
+
+            Field<Member>* newArray = new Field<Member>[newSize];
+            if (!newArray)
+            {
+                return false;
+            }
+
+            Field<Member>* originalArray = FieldArray<Member>(column);
+
+            for (size_t i = 0; i < moveCount; ++i)
+            {
+                newArray[i] = originalArray[i];
+            }
+
+            for (size_t i = moveCount; i < newSize; ++i)
+            {
+                newArray[i].value = defaults.*Member;
+            }
+
+            delete[] originalArray;
+            static_cast<void**>(column)[IndexOf<Member>] = newArray;
+            return true;
+        }
+    };
+}
@@ -0,0 +1,159 @@
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+
+#include "EntityReference.hpp"
+
+namespace Hyperion::ECS
+{
+    template <typename Rel>
+    class RelationIndex;
+
+    /**
+     * @brief Relationship component: the entity holding it relates to a target entity through Rel.
+     *
+     * Pairs are sparse components set with World::Relate and cleared with World::Unrelate (or
+     * RemoveComponents), and can be requested as `Pair<Rel>*` in Iterate and Access. An entity
+     * has at most one target per relation type. Sources of a target are linked together, so
+     * World::ForEachSource visits them without scanning the world.
+     * @tparam Rel Tag type naming the relation, e.g. `struct OwnedBy {};`.
+     */
+    template <typename Rel>
+    class Pair
+    {
+        friend class RelationIndex<Rel>;
+        friend struct World;
+
+        EntityReference target;
+        Index next = InvalidIndex;          /**< Next source of the same target. */
+        Index previous = InvalidIndex;      /**< Previous source of the same target. */
+
+    public:
+        /**
+         * @brief Get the target of the relation.
+         * @return A reference to the target, or an empty one if the pair was added without World::Relate.
+         */
+        const EntityReference& GetTarget() const { return target; }
+    };
+
+    /**
+     * @brief Pairs are stored in sparse sets, relating or unrelating never migrates an entity.
+     */
+    template <typename Rel>
+    struct SparseStorage<Pair<Rel>> : std::true_type
+    {
+        static void OnRemove(Index, Pair<Rel>& pair) { RelationIndex<Rel>::Unlink(pair); }
+        static void OnDestroy(Index record) { RelationIndex<Rel>::ReleaseTarget(record); }
+    };
+
+    /**
+     * @brief Reverse index of a relation type: the first source of each target record.
+     * @tparam Rel Tag type naming the relation.
+     */
+    template <typename Rel>
+    class RelationIndex
+    {
+        friend struct SparseStorage<Pair<Rel>>;
+        friend struct World;
+
+        static inline Index* heads = nullptr;
+        static inline size_t capacity = 0;
+
+        /**
+         * @brief Grow the index to cover a target record.
+         * @return true if the record is covered.
+         */
+        static bool Reserve(Index target)
+        {
+            if (target < capacity) return true;
+
+            size_t newCapacity = (capacity == 0) ? 16 : capacity;
+            while (newCapacity <= target)
+            {
+                newCapacity = (newCapacity * 2) - (newCapacity / 2);
+            }
+
+            Index* newHeads = static_cast<Index*>(realloc(heads, sizeof(Index) * newCapacity));
+            if (!newHeads) return false;
+
+            for (size_t i = capacity; i < newCapacity; i++)
+            {
+                newHeads[i] = InvalidIndex;
+            }
+            heads = newHeads;
+            capacity = newCapacity;
+            return true;
+        }
+
+        /**
+         * @brief Get the first source of a target record.
+         */
+        static Index First(Index target)
+        {
+            return (target < capacity) ? heads[target] : InvalidIndex;
+        }
+
+        /**
+         * @brief Insert a source at the front of the list of its target.
+         * @param source The record of the source, holding the pair.
+         * @param pair The pair of the source, with its target set.
+         * @return true if linked.
+         */
+        static bool Link(Index source, Pair<Rel>& pair)
+        {
+            const Index target = pair.target.recordIndex;
+            if (!Reserve(target)) return false;
+
+            pair.previous = InvalidIndex;
+            pair.next = heads[target];
+            if (pair.next != InvalidIndex)
+            {
+                SparseSet<Pair<Rel>>::Find(pair.next)->previous = source;
+            }
+            heads[target] = source;
+            return true;
+        }
+
+        /**
+         * @brief Remove a source from the list of its target, leaving the pair without target.
+         * @param pair The pair of the source.
+         */
+        static void Unlink(Pair<Rel>& pair)
+        {
+            const Index target = pair.target.recordIndex;
+            if (target == InvalidIndex) return;
+
+            if (pair.previous != InvalidIndex)
+            {
+                SparseSet<Pair<Rel>>::Find(pair.previous)->next = pair.next;
+            }
+            else
+            {
+                heads[target] = pair.next;
+            }
+
+            if (pair.next != InvalidIndex)
+            {
+                SparseSet<Pair<Rel>>::Find(pair.next)->previous = pair.previous;
+            }
+
+            pair.target = EntityReference();
+            pair.next = InvalidIndex;
+            pair.previous = InvalidIndex;
+        }
+
+        /**
+         * @brief Remove the pairs of every source of a destroyed target.
+         * @param target The record of the destroyed entity.
+         */
+        static void ReleaseTarget(Index target)
+        {
+            for (Index source = First(target); source != InvalidIndex; source = First(target))
+            {
+                SparseSet<Pair<Rel>>::Remove(source);
+            }
+        }
+    };
+}
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <stddef.h>
+
+#include "../Utils/std/type_traits.h"
+
+#ifndef HYPERION_RESOURCE_BYTES
+/**
+ * @brief Largest size of the block holding all world resources, can be overridden per project.
+ */
+#define HYPERION_RESOURCE_BYTES 2048
+#endif
+
+namespace Hyperion::ECS
+{
+    /**
+     * @brief Slot of one resource type in the resource block.
+     */
+    template <typename T>
+    struct ResourceSlot
+    {
+        T value{};
+    };
+
+    /**
+     * @brief Storage of world resources: one instance per declared type, packed in a single static block.
+     *
+     * The block is a struct with a member per resource, so the offset of each resource is set at
+     * compile time and reaching it costs a single load, with no lookup nor query. The block is
+     * constant initialized, resources are usable before any static constructor runs. Since all
+     * resources share one block, saving or restoring them is a single copy.
+     * @tparam Ts The resource types, trivially copyable and each listed once.
+     */
+    template <typename... Ts>
+    struct ResourceList
+    {
+        static_assert((std::is_trivially_copyable_v<Ts> && ...), "Resources must be trivially copyable to be saved and restored.");
+
+        struct Block : ResourceSlot<Ts>...
+        {
+        };
+
+        /**
+         * @brief Number of bytes used by the resources.
+         */
+        static constexpr size_t Size = sizeof...(Ts) ? sizeof(Block) : 0;
+
+        static_assert(Size <= HYPERION_RESOURCE_BYTES, "World resources exceed HYPERION_RESOURCE_BYTES.");
+
+        constinit static inline Block block{};
+
+        /**
+         * @brief Check whether a type is a declared resource.
+         * @tparam T The resource type.
+         */
+        template <typename T>
+        static constexpr bool Contains = (std::is_same_v<T, Ts> || ...);
+
+        /**
+         * @brief Get the instance of a resource type.
+         * @tparam T The resource type.
+         */
+        template <typename T>
+        static T& Get()
+        {
+            static_assert(Contains<T>, "Resource type not declared in WorldResources.");
+            return static_cast<ResourceSlot<T>&>(block).value;
+        }
+    };
+
+    /**
+     * @brief Resource types of the world, declared once per project before World::Resource is used:
+     * `template <> struct Hyperion::ECS::WorldResources<> : ResourceList<Camera, InputState> {};`
+     * @tparam Tag Unused, it only defers the lookup of the declaration to the point World::Resource is used.
+     */
+    template <typename Tag = void>
+    struct WorldResources : ResourceList<>
+    {
+    };
+
+    /**
+     * @brief Tag making WorldResources depend on a template parameter of its user.
+     */
+    template <typename T>
+    struct ResourceTag
+    {
+        using Type = void;
+    };
+}
@@ -0,0 +1,241 @@
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+
+#include "../Utils/SatAlloc.hpp"
+#include "EntityRecord.hpp"
+#include "Layout.hpp"
+
+namespace Hyperion::ECS
+{
+    /**
+     * @brief Storage trait, components live in archetype columns unless specialized.
+     *
+     * Components toggled often (status effects, input focus...) can be kept out of the
+     * archetype signature, so adding or removing them never migrates the entity, e.g.
+     * `template <> struct Hyperion::ECS::SparseStorage<Stunned> : std::true_type {};`.
+     * A specialization may also provide `static void OnRemove(Index record, T& value)`, called
+     * before a component leaves the set, and `static void OnDestroy(Index record)`, called for
+     * every destroyed entity once the type is in use.
+     * @tparam T The component type.
+     */
+    template <typename T>
+    struct SparseStorage : std::false_type
+    {
+    };
+
+    /**
+     * @brief A component stored in a sparse set instead of archetype columns.
+     * @tparam T The component type.
+     */
+    template <typename T>
+    concept SparseComponent = SparseStorage<T>::value;
+
+    /**
+     * @brief Release functions of all sparse component types, called when an entity is destroyed.
+     */
+    class SparseSets
+    {
+        template <typename T>
+        friend class SparseSet;
+
+        static constexpr size_t MaxSparseTypes = 32;
+
+        static inline void (*releasers[MaxSparseTypes])(Index record) = {};
+        static inline size_t count = 0;
+
+        /**
+         * @brief Register the release function of a sparse component type.
+         * @return true if registered, false once MaxSparseTypes types are in use, in which case Add fails for the new type.
+         */
+        static bool Register(void (*releaser)(Index record))
+        {
+            if (count >= MaxSparseTypes) return false;
+
+            releasers[count++] = releaser;
+            return true;
+        }
+
+    public:
+        /**
+         * @brief Remove every sparse component of a record.
+         * @param record The index of the entity record.
+         */
+        static void RemoveAll(Index record)
+        {
+            for (size_t i = 0; i < count; i++)
+            {
+                releasers[i](record);
+            }
+        }
+    };
+
+    /**
+     * @brief Per-type sparse set: a packed array of components and an index from entity record to position.
+     *
+     * Adding or removing a component is O(1) and touches nothing else of the entity. Components
+     * stay packed, the last one being moved into the slot of a removed one.
+     * @tparam T The component type.
+     */
+    template <typename T>
+    class SparseSet
+    {
+        static_assert(!SplitComponent<T>, "Sparse components cannot use a split layout.");
+
+        static inline Index* sparse = nullptr;      /**< Position in dense of each record, InvalidIndex if absent. */
+        static inline size_t sparseCapacity = 0;
+        static inline T* dense = nullptr;           /**< Packed components. */
+        static inline Index* owners = nullptr;      /**< Record owning each packed component. */
+        static inline Index capacity = 0;
+        static inline Index size = 0;
+        static inline bool registered = false;
+
+        /**
+         * @brief Grow the sparse index to cover a record.
+         * @return true if the record is covered.
+         */
+        static bool ReserveSparse(Index record)
+        {
+            if (record < sparseCapacity) return true;
+
+            size_t newCapacity = (sparseCapacity == 0) ? 16 : sparseCapacity;
+            while (newCapacity <= record)
+            {
+                newCapacity = (newCapacity * 2) - (newCapacity / 2);
+            }
+
+            Index* newSparse = static_cast<Index*>(realloc(sparse, sizeof(Index) * newCapacity));
+            if (!newSparse) return false;
+
+            for (size_t i = sparseCapacity; i < newCapacity; i++)
+            {
+                newSparse[i] = InvalidIndex;
+            }
+            sparse = newSparse;
+            sparseCapacity = newCapacity;
+            return true;
+        }
+
+        /**
+         * @brief Grow the packed arrays by one slot at least.
+         * @return true if there is room for another component.
+         */
+        static bool ReserveDense()
+        {
+            if (size < capacity) return true;
+            if (capacity == InvalidIndex) return false;
+
+            // Grow in size_t, there is one component per record at most so InvalidIndex slots are enough
+            const size_t grown = (capacity == 0) ? 8 : (size_t(capacity) * 2) - (capacity / 2);
+            const Index newCapacity = static_cast<Index>(grown < InvalidIndex ? grown : InvalidIndex);
+            T* newDense = new T[newCapacity];
+            Index* newOwners = static_cast<Index*>(realloc(owners, sizeof(Index) * newCapacity));
+            if (!newDense || !newOwners)
+            {
+                delete[] newDense;
+                if (newOwners) owners = newOwners;
+                return false;
+            }
+
+            for (size_t i = 0; i < size; i++)
+            {
+                newDense[i] = std::move(dense[i]);
+            }
+            delete[] dense;
+
+            dense = newDense;
+            owners = newOwners;
+            capacity = newCapacity;
+            return true;
+        }
+
+    public:
+        /**
+         * @brief Get the component of a record.
+         * @param record The index of the entity record.
+         * @return A pointer to the component, or nullptr if the record does not hold it.
+         */
+        static T* Find(Index record)
+        {
+            if (record >= sparseCapacity) return nullptr;
+            const Index position = sparse[record];
+            return (position == InvalidIndex) ? nullptr : &dense[position];
+        }
+
+        /**
+         * @brief Add the component to a record, default constructed, or get the one it already holds.
+         * @param record The index of the entity record.
+         * @return A pointer to the component, or nullptr if storage could not grow.
+         */
+        static T* Add(Index record)
+        {
+            if (T* component = Find(record)) return component;
+
+            if (!registered)
+            {
+                registered = SparseSets::Register(&Release);
+                if (!registered) return nullptr;
+            }
+
+            if (!ReserveSparse(record) || !ReserveDense()) return nullptr;
+
+            sparse[record] = size;
+            owners[size] = record;
+            return &dense[size++];
+        }
+
+        /**
+         * @brief Remove the component from a record, if it holds it.
+         * @param record The index of the entity record.
+         */
+        static void Remove(Index record)
+        {
+            if (record >= sparseCapacity) return;
+
+            const Index position = sparse[record];
+            if (position == InvalidIndex) return;
+
+            if constexpr (requires { SparseStorage<T>::OnRemove; })
+            {
+                SparseStorage<T>::OnRemove(record, dense[position]);
+            }
+
+            const Index last = --size;
+            if (position != last)
+            {
+                dense[position] = std::move(dense[last]);
+                owners[position] = owners[last];
+                sparse[owners[position]] = position;
+            }
+            dense[last] = T{};
+            sparse[record] = InvalidIndex;
+        }
+
+        /**
+         * @brief Remove the component of a destroyed entity and let the storage trait react.
+         * @param record The index of the entity record.
+         */
+        static void Release(Index record)
+        {
+            Remove(record);
+
+            if constexpr (requires { SparseStorage<T>::OnDestroy; })
+            {
+                SparseStorage<T>::OnDestroy(record);
+            }
+        }
+
+        /**
+         * @brief Get the number of records holding the component.
+         */
+        static Index Size() { return size; }
+
+        /**
+         * @brief Get the record owning the component at a packed position.
+         * @param position The position, lower than Size().
+         */
+        static Index Owner(Index position) { return owners[position]; }
+    };
+}
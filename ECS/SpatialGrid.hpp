@@ -0,0 +1,319 @@
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+
+#include "World.hpp"
+#include "../Math/Frustum.hpp"
+
+namespace Hyperion::ECS
+{
+    /**
+     * @brief A concept for components usable as positions, exposing Fxp x, y and z members (e.g. derived from Vec3).
+     * @tparam T The component type.
+     */
+    template <typename T>
+    concept PositionComponent = requires(T position)
+    {
+        requires std::is_same_v<decltype(position.x), Fxp>;
+        requires std::is_same_v<decltype(position.y), Fxp>;
+        requires std::is_same_v<decltype(position.z), Fxp>;
+    };
+
+    /**
+     * @brief Uniform grid of cubic cells indexing every entity holding a position component.
+     *
+     * The grid is rebuilt from the ECS once per frame with a counting sort: entities are
+     * stored contiguously grouped by cell, and each cell is a [start, end) range into that
+     * array, so no per-cell allocations are made. Positions outside the grid bounds are
+     * clamped into the border cells, queries still test the exact positions.
+     * @tparam T The position component type.
+     */
+    template <PositionComponent T>
+    class SpatialGrid : World::EntityIterator
+    {
+    public:
+        /**
+         * @brief An indexed entity along with the position it had when the grid was built.
+         */
+        struct Entry
+        {
+            Vec3 position;
+            EntityReference entity;
+        };
+
+    private:
+        static constexpr size_t AxisCount = 3;
+
+        Vec3 origin;
+        Fxp cellSize;
+        Fxp inverseCellSize;
+        Index dimensions[AxisCount];
+        size_t cellCount;
+
+        size_t* cellStart = nullptr;    /**< cellCount + 1 offsets into entries. */
+        Entry* entries = nullptr;       /**< Entries sorted by cell. */
+        Entry* unsorted = nullptr;      /**< Entries in iteration order, used while rebuilding. */
+        size_t* entryCell = nullptr;    /**< Cell of each unsorted entry. */
+        size_t capacity = 0;
+        size_t size = 0;
+
+        /**
+         * @brief Get the cell coordinate of a value along one axis, clamped to the grid.
+         */
+        Index CellCoordinate(const Fxp& value, const Fxp& axisOrigin, size_t axis) const
+        {
+            const int32_t coordinate = ((value - axisOrigin) * inverseCellSize).ToInt();
+            if (coordinate < 0) return 0;
+            if (coordinate >= dimensions[axis]) return dimensions[axis] - 1;
+            return static_cast<Index>(coordinate);
+        }
+
+        /**
+         * @brief Get the index of a cell, grids may hold more cells than an Index can count.
+         */
+        size_t CellIndex(Index x, Index y, Index z) const
+        {
+            return (static_cast<size_t>(z) * dimensions[1] + y) * dimensions[0] + x;
+        }
+
+        size_t CellOf(const Vec3& position) const
+        {
+            return CellIndex(CellCoordinate(position.x, origin.x, 0),
+                CellCoordinate(position.y, origin.y, 1),
+                CellCoordinate(position.z, origin.z, 2));
+        }
+
+        bool Reserve(size_t required)
+        {
+            if (required <= capacity) return true;
+
+            size_t newCapacity = (capacity == 0) ? 64 : capacity;
+            while (newCapacity < required)
+            {
+                newCapacity = (newCapacity * 2) - (newCapacity / 2);
+            }
+
+            Entry* newEntries = static_cast<Entry*>(realloc(entries, sizeof(Entry) * newCapacity));
+            if (newEntries) entries = newEntries;
+            Entry* newUnsorted = static_cast<Entry*>(realloc(unsorted, sizeof(Entry) * newCapacity));
+            if (newUnsorted) unsorted = newUnsorted;
+            size_t* newEntryCell = static_cast<size_t*>(realloc(entryCell, sizeof(size_t) * newCapacity));
+            if (newEntryCell) entryCell = newEntryCell;
+
+            if (!newEntries || !newUnsorted || !newEntryCell) return false;
+
+            capacity = newCapacity;
+            return true;
+        }
+
+        /**
+         * @brief Visit every entry of the cells in an inclusive cell range.
+         */
+        template <typename Lambda>
+        void EachCellInRange(const Index (&minCell)[AxisCount], const Index (&maxCell)[AxisCount], Lambda lambda) const
+        {
+            for (Index z = minCell[2]; z <= maxCell[2]; z++)
+            {
+                for (Index y = minCell[1]; y <= maxCell[1]; y++)
+                {
+                    const size_t rowStart = CellIndex(0, y, z);
+                    const size_t first = cellStart[rowStart + minCell[0]];
+                    const size_t last = cellStart[rowStart + maxCell[0] + 1];
+
+                    // Cells along x are adjacent, so the whole row is one contiguous range
+                    for (size_t i = first; i < last; i++)
+                    {
+                        lambda(entries[i]);
+                    }
+                }
+            }
+        }
+
+        void CellRange(const Vec3& min, const Vec3& max, Index (&minCell)[AxisCount], Index (&maxCell)[AxisCount]) const
+        {
+            minCell[0] = CellCoordinate(min.x, origin.x, 0);
+            minCell[1] = CellCoordinate(min.y, origin.y, 1);
+            minCell[2] = CellCoordinate(min.z, origin.z, 2);
+            maxCell[0] = CellCoordinate(max.x, origin.x, 0);
+            maxCell[1] = CellCoordinate(max.y, origin.y, 1);
+            maxCell[2] = CellCoordinate(max.z, origin.z, 2);
+        }
+
+    public:
+        /**
+         * @brief Construct a grid.
+         * @param origin Minimum corner of the grid.
+         * @param cellSize Edge length of a cell.
+         * @param sizeX Number of cells along x.
+         * @param sizeY Number of cells along y.
+         * @param sizeZ Number of cells along z.
+         */
+        SpatialGrid(const Vec3& origin, const Fxp& cellSize, Index sizeX, Index sizeY, Index sizeZ)
+            : origin(origin), cellSize(cellSize), inverseCellSize(Fxp(1.0) / cellSize),
+            dimensions{ sizeX, sizeY, sizeZ }, cellCount(static_cast<size_t>(sizeX) * sizeY * sizeZ)
+        {
+            cellStart = static_cast<size_t*>(malloc(sizeof(size_t) * (cellCount + 1)));
+            for (size_t i = 0; i <= cellCount; i++)
+            {
+                cellStart[i] = 0;
+            }
+        }
+
+        SpatialGrid(const SpatialGrid&) = delete;
+        SpatialGrid& operator=(const SpatialGrid&) = delete;
+
+        ~SpatialGrid()
+        {
+            free(cellStart);
+            free(entries);
+            free(unsorted);
+            free(entryCell);
+        }
+
+        /**
+         * @brief Rebuild the grid from the current position of every entity.
+         */
+        void Rebuild()
+        {
+            size = 0;
+            for (size_t i = 0; i <= cellCount; i++)
+            {
+                cellStart[i] = 0;
+            }
+
+            // Gather positions and count entities per cell, counts are stored one slot ahead
+            Iterate([this](T* position)
+            {
+                if (size >= capacity && !Reserve(size + 1)) return StopIteration();
+
+                Entry& entry = unsorted[size];
+                entry.position = Vec3(position->x, position->y, position->z);
+                entry.entity = GetCurrentEntity();
+
+                const size_t cell = CellOf(entry.position);
+                entryCell[size++] = cell;
+                cellStart[cell + 1]++;
+            });
+
+            // Prefix sum turns counts into the start of each cell
+            for (size_t i = 1; i <= cellCount; i++)
+            {
+                cellStart[i] += cellStart[i - 1];
+            }
+
+            // Scatter, using cellStart[cell] as the write cursor; afterwards each slot holds the next cell start
+            for (size_t i = 0; i < size; i++)
+            {
+                entries[cellStart[entryCell[i]]++] = unsorted[i];
+            }
+
+            for (size_t i = cellCount; i > 0; i--)
+            {
+                cellStart[i] = cellStart[i - 1];
+            }
+            cellStart[0] = 0;
+        }
+
+        /**
+         * @brief Get the number of indexed entities.
+         */
+        size_t Size() const { return size; }
+
+        /**
+         * @brief Get the number of cells.
+         */
+        size_t CellCount() const { return cellCount; }
+
+        /**
+         * @brief Visit the entities whose position lies within an axis-aligned box.
+         * @param min Minimum corner of the box.
+         * @param max Maximum corner of the box.
+         * @param lambda Called with each matching const Entry&.
+         */
+        template <typename Lambda>
+        void QueryBox(const Vec3& min, const Vec3& max, Lambda lambda) const
+        {
+            Index minCell[AxisCount], maxCell[AxisCount];
+            CellRange(min, max, minCell, maxCell);
+
+            EachCellInRange(minCell, maxCell, [&min, &max, &lambda](const Entry& entry)
+            {
+                const Vec3& position = entry.position;
+                if (position.x >= min.x && position.x <= max.x &&
+                    position.y >= min.y && position.y <= max.y &&
+                    position.z >= min.z && position.z <= max.z)
+                {
+                    lambda(entry);
+                }
+            });
+        }
+
+        /**
+         * @brief Visit the entities whose position lies within a sphere.
+         * @param center Center of the sphere.
+         * @param radius Radius of the sphere.
+         * @param lambda Called with each matching const Entry&.
+         */
+        template <typename Lambda>
+        void QueryRadius(const Vec3& center, const Fxp& radius, Lambda lambda) const
+        {
+            const Vec3 extent(radius, radius, radius);
+            Index minCell[AxisCount], maxCell[AxisCount];
+            CellRange(center - extent, center + extent, minCell, maxCell);
+
+            // Squared distances are compared on raw values in 64 bits to avoid Fxp overflow
+            const int64_t radiusSquared = static_cast<int64_t>(radius.Value()) * radius.Value();
+
+            EachCellInRange(minCell, maxCell, [&center, radiusSquared, &lambda](const Entry& entry)
+            {
+                const int64_t dx = entry.position.x.Value() - center.x.Value();
+                const int64_t dy = entry.position.y.Value() - center.y.Value();
+                const int64_t dz = entry.position.z.Value() - center.z.Value();
+                if (dx * dx + dy * dy + dz * dz <= radiusSquared)
+                {
+                    lambda(entry);
+                }
+            });
+        }
+
+        /**
+         * @brief Visit the entities of every non-empty cell intersecting a frustum.
+         * Cells are tested with Frustum::BoxInFrustum, so the result is conservative: entities close
+         * to the frustum but outside of it can be reported and should be refined by the caller if needed.
+         * @param frustum The view frustum.
+         * @param lambda Called with each const Entry& of a visible cell.
+         */
+        template <typename Lambda>
+        void QueryFrustum(const Frustum& frustum, Lambda lambda) const
+        {
+            const Fxp halfCell = cellSize >> 1;
+            size_t cell = 0;
+
+            for (Index z = 0; z < dimensions[2]; z++)
+            {
+                for (Index y = 0; y < dimensions[1]; y++)
+                {
+                    for (Index x = 0; x < dimensions[0]; x++, cell++)
+                    {
+                        const size_t first = cellStart[cell];
+                        const size_t last = cellStart[cell + 1];
+                        if (first == last) continue;
+
+                        const Vec3 center(origin.x + cellSize * Fxp::FromInt(x) + halfCell,
+                            origin.y + cellSize * Fxp::FromInt(y) + halfCell,
+                            origin.z + cellSize * Fxp::FromInt(z) + halfCell);
+
+                        if (!frustum.BoxInFrustum(center, cellSize)) continue;
+
+                        for (size_t i = first; i < last; i++)
+                        {
+                            lambda(entries[i]);
+                        }
+                    }
+                }
+            }
+        }
+    };
+}
@@ -0,0 +1,434 @@
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include "../Utils/IdTracker.hpp"
+#include "../Utils/std/utils.h"
+#include "EntityRecord.hpp"
+#include "Component.hpp"
+
+namespace Hyperion::ECS
+{
+    /**
+     * @brief Declares one archetype of a StaticWorld: its components and its maximum population.
+     * @tparam Capacity Maximum number of entities in the archetype.
+     * @tparam Ts The component types.
+     */
+    template <size_t Capacity, typename... Ts>
+    struct StaticArchetype
+    {
+        static_assert(sizeof...(Ts) > 0, "An archetype needs at least one component.");
+        static_assert(Capacity > 0, "An archetype needs room for at least one entity.");
+        static_assert((!SplitComponent<Ts> && ...), "Split components are not supported by static worlds.");
+
+        static constexpr size_t capacity = Capacity;
+
+        /**
+         * @brief Binary identifier of the component set, as used by ArchetypeManager.
+         */
+        static constexpr Component::BinaryId Signature = ((Component::BinaryId(1) << Component::Id<Ts>) | ...);
+
+        /**
+         * @brief Check whether the archetype holds a component type.
+         * @tparam T The component type.
+         */
+        template <typename T>
+        static constexpr bool Contains = (std::is_same_v<T, Ts> || ...);
+    };
+
+    /**
+     * @brief Statically sized column of one component.
+     */
+    template <typename T, size_t Capacity>
+    struct StaticColumn
+    {
+        T data[Capacity];
+    };
+
+    /**
+     * @brief Rows of one static archetype, every column sized to its capacity.
+     * @tparam Archetype The StaticArchetype declaration.
+     */
+    template <typename Archetype>
+    struct StaticArchetypeStorage;
+
+    template <size_t Capacity, typename... Ts>
+    struct StaticArchetypeStorage<StaticArchetype<Capacity, Ts...>> : StaticColumn<Ts, Capacity>...
+    {
+        Index recordIndices[Capacity];
+        Index size = 0;
+
+        /**
+         * @brief Get the column of a component type.
+         * @tparam T The component type.
+         * @return A pointer to the first row of the column.
+         */
+        template <typename T>
+        T* Column() { return static_cast<StaticColumn<T, Capacity>&>(*this).data; }
+
+        /**
+         * @brief Swap-remove a row, moving the last row into it and resetting the vacated one.
+         * @param row The row to remove.
+         */
+        void RemoveRow(Index row)
+        {
+            const Index last = --size;
+            if (row != last)
+            {
+                ((Column<Ts>()[row] = std::move(Column<Ts>()[last])), ...);
+                recordIndices[row] = recordIndices[last];
+            }
+            ((ResetRow<Ts>(last)), ...);
+        }
+
+    private:
+        template <typename T>
+        void ResetRow(Index row)
+        {
+            if constexpr (std::is_default_constructible_v<T>)
+            {
+                Column<T>()[row] = T{};
+            }
+        }
+    };
+
+    /**
+     * @brief Get the type at a position of a parameter pack.
+     */
+    template <size_t I, typename T, typename... Ts>
+    struct StaticTypeAt : StaticTypeAt<I - 1, Ts...> {};
+
+    template <typename T, typename... Ts>
+    struct StaticTypeAt<0, T, Ts...>
+    {
+        using Type = T;
+    };
+
+    /**
+     * @brief World whose archetypes and populations are fixed at compile time.
+     *
+     * Complements the dynamic World the way FixedIdTracker complements IdTracker: every
+     * archetype column, row bookkeeping and entity record lives in one static block sized
+     * from the declarations, archetypes are resolved at compile time and no heap is used.
+     * Entities cannot change archetype, and creation fails once an archetype is full.
+     * Usage:
+     * `using Scene = StaticWorld<StaticArchetype<64, Position, Velocity>, StaticArchetype<8, Position, Camera>>;`
+     * @tparam Archetypes The StaticArchetype declarations.
+     */
+    template <typename... Archetypes>
+    class StaticWorld
+    {
+    public:
+        static constexpr size_t ArchetypeCount = sizeof...(Archetypes);
+        static constexpr size_t capacity = (Archetypes::capacity + ...);
+
+        static_assert(ArchetypeCount > 0, "A static world needs at least one archetype.");
+        static_assert(capacity < InvalidIndex, "Static world capacity exceeds the entity index range.");
+
+    private:
+        template <size_t I>
+        using ArchetypeAt = typename StaticTypeAt<I, Archetypes...>::Type;
+
+        /**
+         * @brief Entity record, locating an entity within the static block.
+         */
+        struct Record
+        {
+            Index archetype = InvalidIndex;
+            Index row = InvalidIndex;
+            Index version = 0;
+        };
+
+        template <size_t I, typename Archetype>
+        struct Slot
+        {
+            StaticArchetypeStorage<Archetype> storage;
+        };
+
+        template <typename Indices>
+        struct Block;
+
+        /**
+         * @brief The single static block holding the whole world.
+         */
+        template <size_t... Is>
+        struct Block<Sequence<Is...>> : Slot<Is, Archetypes>...
+        {
+            Record records[capacity];
+            FixedIdTracker<capacity> recordIds;
+        };
+
+        static inline Block<CreateIndexSequence<ArchetypeCount>> block;
+
+        template <size_t I>
+        static StaticArchetypeStorage<ArchetypeAt<I>>& Storage()
+        {
+            return static_cast<Slot<I, ArchetypeAt<I>>&>(block).storage;
+        }
+
+        /**
+         * @brief Get the index of the archetype declared with exactly a set of components.
+         * @tparam Ts The component types, in any order.
+         */
+        template <typename... Ts>
+        static constexpr size_t IndexOf = []()
+        {
+            constexpr Component::BinaryId signature = ((Component::BinaryId(1) << Component::Id<Ts>) | ...);
+            constexpr Component::BinaryId signatures[] = { Archetypes::Signature... };
+            size_t index = 0;
+            while (index < ArchetypeCount && signatures[index] != signature) index++;
+            return index;
+        }();
+
+        /**
+         * @brief Call a templated lambda with the index of a runtime archetype index as template argument.
+         * @param archetype The archetype index.
+         * @param lambda Templated lambda taking a size_t template parameter and returning bool.
+         * @return The value returned by the lambda, false for an out of range index.
+         */
+        template <typename Lambda>
+        static bool Visit(size_t archetype, Lambda lambda)
+        {
+            return [archetype, &lambda]<size_t... Is>(Sequence<Is...>)
+            {
+                bool result = false;
+                ((archetype == Is && (result = lambda.template operator()<Is>(), true)) || ...);
+                return result;
+            }(CreateIndexSequence<ArchetypeCount>{});
+        }
+
+        /**
+         * @brief Reserve a row and a record in an archetype.
+         * @return The record index, or InvalidIndex if the archetype or the world is full.
+         */
+        template <size_t I>
+        static Index Reserve()
+        {
+            auto& storage = Storage<I>();
+            size_t recordIndex;
+            if (storage.size >= ArchetypeAt<I>::capacity || !block.recordIds.AssingId(recordIndex))
+            {
+                return InvalidIndex;
+            }
+
+            const Index row = storage.size++;
+            storage.recordIndices[row] = static_cast<Index>(recordIndex);
+
+            Record& record = block.records[recordIndex];
+            record.archetype = static_cast<Index>(I);
+            record.row = row;
+            return static_cast<Index>(recordIndex);
+        }
+
+    public:
+        /**
+         * @brief Reference to an entity of the static world.
+         */
+        class EntityReference
+        {
+            friend class StaticWorld;
+
+            Index recordIndex = InvalidIndex;
+            Index version = InvalidIndex;
+
+            EntityReference(Index recordIndex) : recordIndex(recordIndex), version(block.records[recordIndex].version) {}
+
+        public:
+            /**
+             * @brief Default constructor for creating an empty EntityReference.
+             */
+            EntityReference() = default;
+
+            /**
+             * @brief Check whether the referenced entity is still alive.
+             */
+            bool IsValid() const
+            {
+                return recordIndex != InvalidIndex && version == block.records[recordIndex].version;
+            }
+
+            /**
+             * @brief Access the entity's components and execute a lambda function.
+             * @tparam Lambda The lambda function to execute.
+             * @param lambda The lambda function to execute, providing access to the entity's components.
+             * @return true if the entity is alive, holds the components and the lambda executed, false otherwise.
+             */
+            template <typename Lambda>
+            bool Access(Lambda lambda)
+            {
+                if (!IsValid()) return false;
+
+                const Record& record = block.records[recordIndex];
+                using LambdaTraits = LambdaUtil<decltype(&Lambda::operator())>;
+                return LambdaTraits::CallWithTypes([&lambda, &record]<typename ...Components>()
+                {
+                    return Visit(record.archetype, [&lambda, &record]<size_t I>()
+                    {
+                        if constexpr ((ArchetypeAt<I>::template Contains<Components> && ...))
+                        {
+                            auto& storage = Storage<I>();
+                            lambda(&storage.template Column<Components>()[record.row]...);
+                            return true;
+                        }
+                        else
+                        {
+                            return false;
+                        }
+                    });
+                });
+            }
+
+            /**
+             * @brief Destroy the referenced entity.
+             */
+            void Destroy()
+            {
+                if (IsValid())
+                {
+                    Record& record = block.records[recordIndex];
+                    Visit(record.archetype, [&record]<size_t I>()
+                    {
+                        auto& storage = Storage<I>();
+                        storage.RemoveRow(record.row);
+                        if (record.row < storage.size)
+                        {
+                            block.records[storage.recordIndices[record.row]].row = record.row;
+                        }
+                        return true;
+                    });
+
+                    record.archetype = InvalidIndex;
+                    record.row = InvalidIndex;
+                    record.version++;
+                    block.recordIds.FreeId(recordIndex);
+                }
+                recordIndex = InvalidIndex;
+            }
+        };
+
+        /**
+         * @brief Create a new entity with specific component types.
+         * The component set must match one of the declared archetypes exactly.
+         * @tparam Ts The component types to include in the entity.
+         * @return An EntityReference to the created entity, empty if its archetype is full.
+         */
+        template <typename... Ts>
+        static EntityReference CreateEntity()
+        {
+            static_assert(IndexOf<Ts...> < ArchetypeCount, "No static archetype is declared with these components.");
+            const Index recordIndex = Reserve<IndexOf<Ts...>>();
+            return (recordIndex != InvalidIndex) ? EntityReference(recordIndex) : EntityReference();
+        }
+
+        /**
+         * @brief Create a new entity with components using a lambda function.
+         * @tparam Lambda The lambda function to initialize entity components.
+         * @param lambda The lambda function to initialize the components.
+         * @return An EntityReference to the created entity, empty if its archetype is full.
+         */
+        template <typename Lambda>
+        static EntityReference CreateEntity(Lambda lambda)
+        {
+            using LambdaTraits = LambdaUtil<decltype(&Lambda::operator())>;
+            return LambdaTraits::CallWithTypes([&lambda]<typename ...Ts>()
+            {
+                constexpr size_t archetype = IndexOf<Ts...>;
+                static_assert(archetype < ArchetypeCount, "No static archetype is declared with these components.");
+
+                const Index recordIndex = Reserve<archetype>();
+                if (recordIndex == InvalidIndex) return EntityReference();
+
+                auto& storage = Storage<archetype>();
+                const Index row = block.records[recordIndex].row;
+                lambda(&storage.template Column<Ts>()[row]...);
+                return EntityReference(recordIndex);
+            });
+        }
+
+        /**
+         * @brief Get the number of entities in the archetype declared with a set of components.
+         * @tparam Ts The component types.
+         */
+        template <typename... Ts>
+        static size_t Count()
+        {
+            static_assert(IndexOf<Ts...> < ArchetypeCount, "No static archetype is declared with these components.");
+            return Storage<IndexOf<Ts...>>().size;
+        }
+
+        /**
+         * @brief Represents an iterator for entities in the static world.
+         */
+        class EntityIterator
+        {
+            Index currentArchetype = InvalidIndex;
+            Index currentRow = InvalidIndex;
+            bool stop = false;
+
+            template <size_t I, typename Lambda, typename... Components>
+            void IterateArchetype(Lambda& lambda)
+            {
+                if constexpr ((ArchetypeAt<I>::template Contains<Components> && ...))
+                {
+                    if (stop) return;
+
+                    auto& storage = Storage<I>();
+                    currentArchetype = I;
+                    [this, &lambda, &storage](Components* ...columns)
+                    {
+                        for (currentRow = 0; !stop && currentRow < storage.size; currentRow++)
+                        {
+                            lambda(&columns[currentRow]...);
+                        }
+                    }(storage.template Column<Components>()...);
+                }
+            }
+
+        public:
+            /**
+             * @brief Stops the current iteration.
+             */
+            void StopIteration() { stop = true; };
+
+            /**
+             * @brief Get a reference to the current entity in the iteration.
+             * @return An EntityReference to the current entity, if available, or an empty one.
+             */
+            EntityReference GetCurrentEntity()
+            {
+                if (currentRow == InvalidIndex) return EntityReference();
+
+                Index recordIndex = InvalidIndex;
+                Visit(currentArchetype, [this, &recordIndex]<size_t I>()
+                {
+                    recordIndex = Storage<I>().recordIndices[currentRow];
+                    return true;
+                });
+                return EntityReference(recordIndex);
+            }
+
+            /**
+             * @brief Iterate over entities with specified component types and execute a lambda function.
+             * Matching archetypes are selected at compile time.
+             * @tparam Lambda The lambda function to execute for each entity.
+             * @param lambda The lambda function to execute for each entity, providing access to entity components.
+             */
+            template <typename Lambda>
+            void Iterate(Lambda lambda)
+            {
+                stop = false;
+                using LambdaTraits = LambdaUtil<decltype(&Lambda::operator())>;
+                LambdaTraits::CallWithTypes([this, &lambda]<typename ...Components>()
+                {
+                    [this, &lambda]<size_t... Is>(Sequence<Is...>)
+                    {
+                        (IterateArchetype<Is, Lambda, Components...>(lambda), ...);
+                    }(CreateIndexSequence<ArchetypeCount>{});
+                });
+                currentArchetype = InvalidIndex;
+                currentRow = InvalidIndex;
+            }
+        };
+    };
+}
@@ -1,7 +1,10 @@
 #pragma once
 
 #include "EntityReference.hpp"
-#include "..\Utils\std\utils.h"
+#include "Relation.hpp"
+#include "Group.hpp"
+#include "Resource.hpp"
+#include "../Utils/std/utils.h"
 
 namespace Hyperion::ECS
 {
@@ -14,7 +17,7 @@ namespace Hyperion::ECS
          * @brief Create a new entity with components using a lambda function.
          * @tparam Lambda The lambda function to initialize entity components.
          * @param lambda The lambda function to initialize the components.
-         * @return An EntityReference to the created entity.
+         * @return An EntityReference to the created entity, invalid if no entity record is left.
          */
         template <typename Lambda>
         static EntityReference CreateEntity(Lambda lambda)
@@ -23,8 +26,16 @@ namespace Hyperion::ECS
             return LambdaTraits::CallWithTypes([&lambda]<typename ...Ts>()
             {
                 auto& manager = ArchetypeManager::Helper<Ts...>::GetInstance();
-                const EntityRecord& record = manager.ReserveRecord();
-                lambda(&manager.template GetComponentArray<Ts>()[record.row] ...);
+                const EntityRecord* reserved = manager.ReserveRecord();
+                if (!reserved) return EntityReference();
+
+                const EntityRecord& record = *reserved;
+                ArchetypeManager::Helper<Ts...>::AddSparse(record.GetIndex());
+                [&lambda](ArchetypeManager::Column<Ts>... columns)
+                {
+                    lambda(columns.Get()...);
+                    (columns.Store(), ...);
+                }(ArchetypeManager::Column<Ts>(manager, record.row)...);
                 return EntityReference(record);
             });
         }
@@ -32,13 +43,304 @@ namespace Hyperion::ECS
         /**
          * @brief Create a new entity with specific component types.
          * @tparam Ts The component types to include in the entity.
-         * @return An EntityReference to the created entity.
+         * @return An EntityReference to the created entity, invalid if no entity record is left.
          */
         template <typename... Ts>
         static EntityReference CreateEntity()
         {
             ArchetypeManager& manager = ArchetypeManager::Helper<Ts...>::GetInstance();
-            return EntityReference(manager.ReserveRecord());
+            const EntityRecord* record = manager.ReserveRecord();
+            if (!record) return EntityReference();
+
+            ArchetypeManager::Helper<Ts...>::AddSparse(record->GetIndex());
+            return EntityReference(*record);
+        }
+
+        /**
+         * @brief Access the components of many referenced entities at once, in memory order.
+         *
+         * References are validated in one pass, then sorted by archetype and row so that each
+         * archetype is resolved once and its columns are walked forward instead of at random.
+         * References to destroyed entities, or to entities missing one of the requested
+         * components, are skipped. The lambda may run batches of its own.
+         * @tparam Lambda The lambda function to execute, with the same signature as for EntityReference::Access.
+         * @param references The references to access.
+         * @param count The number of references.
+         * @param lambda The lambda function to execute for each valid reference.
+         * @param invalid Optional array of at least count elements receiving the skipped references.
+         * @return The number of skipped references.
+         */
+        template <typename Lambda>
+        static size_t AccessBatch(const EntityReference* references, size_t count, Lambda lambda, EntityReference* invalid = nullptr)
+        {
+            using LambdaTraits = LambdaUtil<decltype(&Lambda::operator())>;
+            return LambdaTraits::CallWithTypes([references, count, &lambda, invalid]<typename ...Components>()
+            {
+                const Component::BinaryId requiredId = ArchetypeManager::Helper<Components...>::id;
+                size_t invalidCount = 0;
+
+                if (!BatchBuffer::Reserve(count)) return count;
+                BatchBuffer::Slice slice(count);
+                uint32_t* keys = slice.Keys();
+
+                // Validate versions and build (archetype, row) keys, tracking which key bits vary
+                size_t validCount = 0;
+                uint32_t anyBits = 0;
+                uint32_t allBits = ~uint32_t(0);
+                uint32_t previousKey = 0;
+                bool ordered = true;
+                for (size_t i = 0; i < count; i++)
+                {
+                    const EntityReference& reference = references[i];
+                    if (reference.recordIndex != InvalidIndex)
+                    {
+                        const EntityRecord& record = EntityRecord::records[reference.recordIndex];
+                        if (reference.Matches(record) &&
+                            (ArchetypeManager::managers[record.archetype].id & requiredId) == requiredId &&
+                            (HoldsSparse<Components>(reference.recordIndex) && ...))
+                        {
+                            const uint32_t key = (static_cast<uint32_t>(record.archetype) << 16) | record.row;
+                            keys[validCount++] = key;
+                            anyBits |= key;
+                            allBits &= key;
+                            ordered = ordered && (previousKey <= key);
+                            previousKey = key;
+                            continue;
+                        }
+                    }
+
+                    if (invalid) invalid[invalidCount] = reference;
+                    invalidCount++;
+                }
+
+                if (!ordered) slice.Sort(validCount, anyBits ^ allBits);
+
+                // The lambda may run batches of its own, which can move the buffers: keys are read through the slice
+                for (size_t i = 0; i < validCount;)
+                {
+                    const Index archetypeIndex = static_cast<Index>(slice.Sorted()[i] >> 16);
+                    ArchetypeManager& archetype = ArchetypeManager::managers[archetypeIndex];
+
+                    for (; i < validCount && (slice.Sorted()[i] >> 16) == archetypeIndex; i++)
+                    {
+                        const Index row = static_cast<Index>(slice.Sorted()[i]);
+                        [&lambda](ArchetypeManager::Column<Components>... columns)
+                        {
+                            lambda(columns.Get()...);
+                            (columns.Store(), ...);
+                        }(ArchetypeManager::Column<Components>(archetype, row)...);
+                    }
+                }
+
+                return invalidCount;
+            });
+        }
+
+        /**
+         * @brief Register the hook called with the entities that gained a component.
+         * Covers creation and migration; entities that lost the component again before the flush are skipped.
+         * @tparam T The component type.
+         * @param hook The hook, or nullptr to unregister it.
+         */
+        template <typename T>
+        static void OnAdd(ComponentHook<T> hook)
+        {
+            SetHook<T>(ComponentHooks::Add, hook);
+        }
+
+        /**
+         * @brief Register the hook called with the entities whose component was written with EntityReference::Set.
+         * @tparam T The component type.
+         * @param hook The hook, or nullptr to unregister it.
+         */
+        template <typename T>
+        static void OnSet(ComponentHook<T> hook)
+        {
+            SetHook<T>(ComponentHooks::Set, hook);
+        }
+
+        /**
+         * @brief Register the hook called with the entities that lost a component.
+         * Covers destruction and migration; the span holds the values the components had when removed.
+         * @tparam T The component type, trivially copyable.
+         * @param hook The hook, or nullptr to unregister it.
+         */
+        template <typename T>
+        static void OnRemove(ComponentHook<T> hook)
+        {
+            static_assert(std::is_trivially_copyable_v<T>, "Removal hooks save component values, which must be trivially copyable.");
+            SetHook<T>(ComponentHooks::Remove, hook);
+        }
+
+        /**
+         * @brief Deliver the lifecycle events recorded since the last flush.
+         *
+         * Every hook is called once per archetype holding affected entities, with a span of their
+         * rows. Hooks may read and write the components of the span, but structural changes made
+         * from a hook (creating, destroying or migrating entities) must not touch the archetypes
+         * being delivered; they are recorded for the next flush.
+         */
+        static void FlushHooks()
+        {
+            if (ComponentHooks::flushing) return;
+
+            ComponentHooks::flushing = true;
+            ComponentHooks::flushQueued = false;
+            for (size_t componentId = 0; componentId < Component::MaxComponentTypes; componentId++)
+            {
+                if (ComponentHooks::entries[componentId])
+                {
+                    ComponentHooks::entries[componentId]->dispatch(componentId);
+                }
+            }
+            ComponentHooks::flushing = false;
+        }
+
+        /**
+         * @brief Deliver hooks through EventManager instead of explicit FlushHooks calls.
+         * When enabled, the first event recorded after a flush queues a ComponentHooksPending
+         * event, and hooks run during EventManager::ProcessQueuedEvents.
+         * @param enable true to deliver through queued events.
+         */
+        static void DeliverHooksWithEvents(bool enable)
+        {
+            static bool listening = false;
+            if (enable && !listening)
+            {
+                EventManager::AddListener<ComponentHooksPending>(&World::FlushHooks);
+                listening = true;
+            }
+            ComponentHooks::deliverWithEvents = enable;
+        }
+
+        /**
+         * @brief Relate an entity to a target, replacing its previous target for this relation.
+         * @tparam Rel Tag type naming the relation.
+         * @param source The entity holding the relation.
+         * @param target The target entity.
+         * @return true if both entities are valid and now related, false otherwise.
+         */
+        template <typename Rel>
+        static bool Relate(const EntityReference& source, const EntityReference& target)
+        {
+            if (!IsValid(source) || !IsValid(target)) return false;
+
+            Pair<Rel>* pair = SparseSet<Pair<Rel>>::Add(source.recordIndex);
+            if (!pair) return false;
+
+            RelationIndex<Rel>::Unlink(*pair);
+            pair->target = target;
+            if (!RelationIndex<Rel>::Link(source.recordIndex, *pair))
+            {
+                pair->target = EntityReference();
+                return false;
+            }
+            return true;
+        }
+
+        /**
+         * @brief Remove the relation of an entity.
+         * @tparam Rel Tag type naming the relation.
+         * @param source The entity holding the relation.
+         * @return true if the entity is valid and no longer related, false otherwise.
+         */
+        template <typename Rel>
+        static bool Unrelate(EntityReference source)
+        {
+            return source.RemoveComponents<Pair<Rel>>();
+        }
+
+        /**
+         * @brief Get the target of an entity for a relation.
+         * @tparam Rel Tag type naming the relation.
+         * @param source The entity holding the relation.
+         * @return A reference to the target, or an empty one if the entity is not related.
+         */
+        template <typename Rel>
+        static EntityReference GetTarget(const EntityReference& source)
+        {
+            if (!IsValid(source)) return EntityReference();
+
+            const Pair<Rel>* pair = SparseSet<Pair<Rel>>::Find(source.recordIndex);
+            return pair ? pair->target : EntityReference();
+        }
+
+        /**
+         * @brief Call a function for every entity related to a target, in O(number of sources).
+         * The function may unrelate or destroy the source it is given.
+         * @tparam Rel Tag type naming the relation.
+         * @param target The target entity.
+         * @param lambda Function taking the EntityReference of each source.
+         * @return The number of sources visited.
+         */
+        template <typename Rel, typename Lambda>
+        static size_t ForEachSource(const EntityReference& target, Lambda lambda)
+        {
+            if (!IsValid(target)) return 0;
+
+            size_t count = 0;
+            Index source = RelationIndex<Rel>::First(target.recordIndex);
+            while (source != InvalidIndex)
+            {
+                const Index next = SparseSet<Pair<Rel>>::Find(source)->next;
+                lambda(EntityReference(EntityRecord::records[source]));
+                count++;
+                source = next;
+            }
+            return count;
+        }
+
+        /**
+         * @brief Get the world resource of a type, a single instance shared by all systems.
+         * Resources are declared in WorldResources and default constructed at compile time,
+         * e.g. `World::Resource<Camera>().position`.
+         * @tparam T The resource type, trivially copyable.
+         * @return A reference to the resource.
+         */
+        template <typename T>
+        static T& Resource()
+        {
+            return WorldResources<typename ResourceTag<T>::Type>::template Get<T>();
+        }
+
+        /**
+         * @brief Get the number of bytes needed to save all world resources.
+         */
+        template <typename Tag = void>
+        static size_t ResourcesSize()
+        {
+            return WorldResources<typename ResourceTag<Tag>::Type>::Size;
+        }
+
+        /**
+         * @brief Copy all world resources to a buffer, e.g. as part of a snapshot.
+         * @param buffer Destination of at least ResourcesSize() bytes.
+         */
+        template <typename Tag = void>
+        static void SaveResources(void* buffer)
+        {
+            using Resources = WorldResources<typename ResourceTag<Tag>::Type>;
+            memcpy(buffer, &Resources::block, Resources::Size);
+        }
+
+        /**
+         * @brief Restore all world resources from a buffer filled by SaveResources.
+         * @param buffer Source of ResourcesSize() bytes.
+         */
+        template <typename Tag = void>
+        static void LoadResources(const void* buffer)
+        {
+            using Resources = WorldResources<typename ResourceTag<Tag>::Type>;
+            memcpy(&Resources::block, buffer, Resources::Size);
+        }
+
+        /**
+         * @brief Get the number of archetypes created so far.
+         * @return The archetype count.
+         */
+        static size_t ArchetypeCount()
+        {
+            return ArchetypeManager::managers.size();
         }
 
         /**
@@ -68,6 +370,7 @@ namespace Hyperion::ECS
 
             /**
              * @brief Iterate over entities with specified component types and execute a lambda function.
+             * When sparse components are requested, the smallest of their sets drives the iteration.
              * @tparam Lambda The lambda function to execute for each entity.
              * @param lambda The lambda function to execute for each entity, providing access to entity components.
              */
@@ -78,26 +381,437 @@ namespace Hyperion::ECS
                 using LambdaTraits = LambdaUtil<decltype(&Lambda::operator())>;
                 LambdaTraits::CallWithTypes([this, lambda]<typename ...Components>()
                 {
-                    using LookupCache = ArchetypeManager::LookupCache<Components...>;
-                    LookupCache::Update();
-
-                    for (size_t managerIndex : LookupCache::matchedIndices)
+                    if constexpr ((SparseComponent<Components> || ...))
                     {
-                        if (stop) break;
-
-                        currentManager = &ArchetypeManager::managers[managerIndex];
+                        IterateSparse<Components...>(lambda);
+                    }
+                    else
+                    {
+                        using QueryCache = ArchetypeManager::QueryCache<Components...>;
+                        if (!QueryCache::Update())
+                        {
+                            IterateUncached<Components...>(lambda);
+                            return;
+                        }
 
-                        [this, lambda](Components* ...componentArray)
+                        for (size_t i = 0; !stop && i < QueryCache::count; i++)
                         {
-                            for (currentRow = 0; !stop && currentRow < currentManager->size; currentRow++)
+                            // Copied, as the lambda may change the world and rebuild the cache
+                            const typename QueryCache::Entry entry = QueryCache::entries[i];
+                            currentManager = &ArchetypeManager::managers[entry.archetype];
+
+                            QueryCache::WithColumns(entry, [this, lambda](ArchetypeManager::Column<Components> ...columns)
                             {
-                                lambda(componentArray++...);
-                            }
-                        }(currentManager->template GetComponentArray<Components>() ...);
+                                for (currentRow = 0; !stop && currentRow < currentManager->size; currentRow++)
+                                {
+                                    lambda(columns.Get()...);
+                                    (columns.Next(), ...);
+                                }
+                            });
+                        }
                     }
                 });
                 currentRow = InvalidIndex;
             }
+
+        private:
+            /**
+             * @brief Iterate over the archetypes matched by LookupCache, resolving the columns of each one.
+             * Used when the query cache cannot grow.
+             */
+            template <typename... Components, typename Lambda>
+            void IterateUncached(Lambda lambda)
+            {
+                using LookupCache = ArchetypeManager::LookupCache<Components...>;
+                LookupCache::Update();
+
+                // Indexed, as the lambda may change the world and add matching archetypes
+                for (size_t i = 0; !stop && i < LookupCache::matchedIndices.size(); i++)
+                {
+                    currentManager = &ArchetypeManager::managers[LookupCache::matchedIndices[i]];
+
+                    [this, lambda](ArchetypeManager::Column<Components> ...columns)
+                    {
+                        for (currentRow = 0; !stop && currentRow < currentManager->size; currentRow++)
+                        {
+                            lambda(columns.Get()...);
+                            (columns.Next(), ...);
+                        }
+                    }(ArchetypeManager::Column<Components>(*currentManager, 0) ...);
+                }
+            }
+
+            /**
+             * @brief Iterate over the entities of the smallest sparse set requested, filtering the other components.
+             * Entities are visited from the end of the sparse set, so the lambda may remove the sparse
+             * components of the current entity.
+             */
+            template <typename... Components, typename Lambda>
+            void IterateSparse(Lambda lambda)
+            {
+                Index (*size)() = nullptr;
+                Index (*owner)(Index) = nullptr;
+                ([&size, &owner]()
+                {
+                    if constexpr (SparseComponent<Components>)
+                    {
+                        if (!size || SparseSet<Components>::Size() < size())
+                        {
+                            size = &SparseSet<Components>::Size;
+                            owner = &SparseSet<Components>::Owner;
+                        }
+                    }
+                }(), ...);
+
+                const Component::BinaryId requiredId = ArchetypeManager::Helper<Components...>::id;
+                for (Index position = size(); !stop && position-- > 0;)
+                {
+                    // The lambda may have removed more than the current entity from the set
+                    if (position >= size()) continue;
+
+                    const Index recordIndex = owner(position);
+                    const EntityRecord& record = EntityRecord::records[recordIndex];
+                    ArchetypeManager& manager = ArchetypeManager::managers[record.archetype];
+                    if (!manager.Contains(requiredId) || !(HoldsSparse<Components>(recordIndex) && ...)) continue;
+
+                    currentManager = &manager;
+                    currentRow = record.row;
+                    [lambda](ArchetypeManager::Column<Components> ...columns)
+                    {
+                        lambda(columns.Get()...);
+                        (columns.Store(), ...);
+                    }(ArchetypeManager::Column<Components>(manager, record.row)...);
+                }
+            }
+        };
+
+    private:
+        /**
+         * @brief Check that a record holds a component if it is sparse, archetype components are matched beforehand.
+         */
+        template <typename T>
+        static bool HoldsSparse(Index record)
+        {
+            if constexpr (SparseComponent<T>)
+            {
+                return SparseSet<T>::Find(record) != nullptr;
+            }
+            else
+            {
+                return true;
+            }
+        }
+
+        /**
+         * @brief Check that a reference designates a live entity.
+         */
+        static bool IsValid(const EntityReference& reference)
+        {
+            return reference.recordIndex != InvalidIndex &&
+                reference.Matches(EntityRecord::records[reference.recordIndex]);
+        }
+
+        /**
+         * @brief Install a hook of one kind for a component type.
+         */
+        template <typename T>
+        static void SetHook(ComponentHooks::Kind kind, ComponentHook<T> hook)
+        {
+            static_assert(!SplitComponent<T>, "Hooks are not supported on split components.");
+            static_assert(!SparseComponent<T>, "Hooks are not supported on sparse components.");
+
+            constexpr size_t componentId = Component::Id<T>;
+            ComponentHooks::Entry*& entry = ComponentHooks::entries[componentId];
+            if (!entry)
+            {
+                entry = new ComponentHooks::Entry();
+                entry->valueSize = sizeof(T);
+                entry->dispatch = &DispatchHooks<T>;
+            }
+
+            entry->hooks[kind] = reinterpret_cast<void*>(hook);
+            if (hook)
+            {
+                ComponentHooks::masks[kind] |= Component::BinaryId(1) << componentId;
+            }
+            else
+            {
+                ComponentHooks::masks[kind] &= ~(Component::BinaryId(1) << componentId);
+            }
+        }
+
+        /**
+         * @brief Scratch spans reused by hook delivery.
+         * Only FlushHooks fills them and it does not run again from a hook, so they are never shared.
+         * Keys are kept apart from AccessBatch, which hooks may call while their spans are delivered.
+         */
+        struct HookBuffer
+        {
+            static inline uint32_t* keys = nullptr;
+            static inline uint32_t* scratch = nullptr;
+            static inline uint32_t* rows = nullptr;
+            static inline EntityReference* entities = nullptr;
+            static inline size_t capacity = 0;
+
+            static bool Reserve(size_t count)
+            {
+                if (count <= capacity) return true;
+
+                size_t newCapacity = (capacity == 0) ? 64 : capacity;
+                while (newCapacity < count)
+                {
+                    newCapacity = (newCapacity * 2) - (newCapacity / 2);
+                }
+
+                uint32_t* newKeys = static_cast<uint32_t*>(realloc(keys, sizeof(uint32_t) * newCapacity));
+                if (newKeys) keys = newKeys;
+                uint32_t* newScratch = static_cast<uint32_t*>(realloc(scratch, sizeof(uint32_t) * newCapacity));
+                if (newScratch) scratch = newScratch;
+                uint32_t* newRows = static_cast<uint32_t*>(realloc(rows, sizeof(uint32_t) * newCapacity));
+                if (newRows) rows = newRows;
+                EntityReference* newEntities = static_cast<EntityReference*>(realloc(entities, sizeof(EntityReference) * newCapacity));
+                if (newEntities) entities = newEntities;
+
+                if (!newKeys || !newScratch || !newRows || !newEntities) return false;
+
+                capacity = newCapacity;
+                return true;
+            }
+        };
+
+        /**
+         * @brief Deliver the recorded events of one component type.
+         * @tparam T The component type.
+         * @param componentId The ID of the component type.
+         */
+        template <typename T>
+        static void DispatchHooks(size_t componentId)
+        {
+            ComponentHooks::Entry& entry = *ComponentHooks::entries[componentId];
+            const Component::BinaryId componentBit = Component::BinaryId(1) << componentId;
+
+            for (size_t kind = 0; kind < ComponentHooks::KindCount; kind++)
+            {
+                if (!entry.queues[kind].size) continue;
+
+                // Without room to deliver them, events stay recorded for the next flush
+                if (!HookBuffer::Reserve(entry.queues[kind].size))
+                {
+                    ComponentHooks::RequestFlush();
+                    continue;
+                }
+
+                const ComponentHooks::Queue& queue = entry.Swap(static_cast<ComponentHooks::Kind>(kind));
+                const ComponentHook<T> hook = reinterpret_cast<ComponentHook<T>>(entry.hooks[kind]);
+                if (!hook) continue;
+                uint32_t* keys = HookBuffer::keys;
+
+                if (kind == ComponentHooks::Remove)
+                {
+                    // Removed values are stored in recording order, group them by source archetype
+                    T* values = reinterpret_cast<T*>(entry.deliveredValues);
+                    for (size_t start = 0; start < queue.size; start += (1 << 16))
+                    {
+                        const size_t count = (queue.size - start < (1 << 16)) ? queue.size - start : (1 << 16);
+                        uint32_t anyBits = 0;
+                        uint32_t allBits = ~uint32_t(0);
+                        for (size_t i = 0; i < count; i++)
+                        {
+                            const uint32_t key = (static_cast<uint32_t>(queue.entries[start + i].archetype) << 16) | static_cast<uint32_t>(i);
+                            keys[i] = key;
+                            anyBits |= key;
+                            allBits &= key;
+                        }
+
+                        const uint32_t* sorted = BatchBuffer::RadixSort(keys, HookBuffer::scratch, count, (anyBits ^ allBits) & 0xFFFF0000u);
+                        for (size_t i = 0; i < count; i++)
+                        {
+                            const ComponentHooks::Pending& pending = queue.entries[start + (sorted[i] & 0xFFFF)];
+                            HookBuffer::rows[i] = static_cast<uint32_t>(start + (sorted[i] & 0xFFFF));
+                            HookBuffer::entities[i].recordIndex = pending.record;
+                            HookBuffer::entities[i].version = pending.version;
+#if HYPERION_RECORD_WIDE_GENERATION
+                            HookBuffer::entities[i].epoch = EntityRecord::records.Epoch(pending.record);
+#endif
+                        }
+
+                        DeliverGroups<T>(hook, sorted, count, [values](Index) { return values; });
+                    }
+                }
+                else
+                {
+                    // Resolve entities to their current rows, skipping the ones that lost the component
+                    size_t count = 0;
+                    for (size_t i = 0; i < queue.size; i++)
+                    {
+                        const ComponentHooks::Pending& pending = queue.entries[i];
+                        const EntityRecord& record = EntityRecord::records[pending.record];
+                        if (pending.version == record.version && (ArchetypeManager::managers[record.archetype].id & componentBit))
+                        {
+                            keys[count++] = (static_cast<uint32_t>(record.archetype) << 16) | record.row;
+                        }
+                    }
+
+                    const uint32_t* sorted = BatchBuffer::RadixSort(keys, HookBuffer::scratch, count, ~uint32_t(0));
+                    size_t unique = 0;
+                    for (size_t i = 0; i < count; i++)
+                    {
+                        // An entity added and set, or set several times, is reported once per kind
+                        if (unique && (sorted[i] == keys[unique - 1])) continue;
+
+                        const Index archetype = static_cast<Index>(sorted[i] >> 16);
+                        const Index row = static_cast<Index>(sorted[i]);
+                        keys[unique] = sorted[i];
+                        HookBuffer::rows[unique] = row;
+                        HookBuffer::entities[unique] = EntityReference(EntityRecord::records[ArchetypeManager::managers[archetype].recordIndices[row]]);
+                        unique++;
+                    }
+
+                    DeliverGroups<T>(hook, keys, unique, [](Index archetype)
+                    {
+                        return ArchetypeManager::managers[archetype].template GetComponentArray<T>();
+                    });
+                }
+            }
+        }
+
+        /**
+         * @brief Call a hook once per archetype over the prepared HookBuffer spans.
+         * @param hook The hook.
+         * @param keys Keys sorted by archetype, in their upper 16 bits.
+         * @param count The number of keys.
+         * @param columnOf Returns the column holding the rows of an archetype.
+         */
+        template <typename T, typename ColumnOf>
+        static void DeliverGroups(ComponentHook<T> hook, const uint32_t* keys, size_t count, ColumnOf columnOf)
+        {
+            for (size_t first = 0; first < count;)
+            {
+                const uint32_t archetype = keys[first] >> 16;
+                size_t last = first + 1;
+                while (last < count && (keys[last] >> 16) == archetype) last++;
+
+                const ComponentSpan<T> span = { columnOf(static_cast<Index>(archetype)), &HookBuffer::rows[first], &HookBuffer::entities[first], last - first };
+                hook(span);
+                first = last;
+            }
+        }
+
+        /**
+         * @brief Scratch keys reused by AccessBatch, so batches do not allocate once warmed up.
+         * Batches run from the lambda of another one each take their own slice.
+         */
+        struct BatchBuffer
+        {
+            static constexpr size_t RadixBits = 8;
+            static constexpr size_t RadixSize = 1 << RadixBits;
+
+            static inline uint32_t* keys = nullptr;
+            static inline uint32_t* scratch = nullptr;
+            static inline size_t capacity = 0;
+            static inline size_t top = 0;      /**< End of the slices taken by the batches running. */
+
+            /**
+             * @brief Keys of one batch, nested batches take the keys above it and give them back on return.
+             * Nested batches may move the buffers, so keys are reached through the slice instead of kept pointers.
+             */
+            struct Slice
+            {
+                size_t base;
+                bool sortedInScratch = false;
+
+                /**
+                 * @brief Take a number of keys, reserved beforehand with Reserve.
+                 */
+                explicit Slice(size_t count) : base(top) { top += count; }
+                ~Slice() { top = base; }
+
+                Slice(const Slice&) = delete;
+                Slice& operator=(const Slice&) = delete;
+
+                uint32_t* Keys() const { return keys + base; }
+
+                /**
+                 * @brief Get the keys, sorted if Sort was called.
+                 */
+                const uint32_t* Sorted() const { return (sortedInScratch ? scratch : keys) + base; }
+
+                void Sort(size_t count, uint32_t varyingBits)
+                {
+                    sortedInScratch = RadixSort(Keys(), scratch + base, count, varyingBits) != Keys();
+                }
+            };
+
+            /**
+             * @brief Make room for a number of keys above the slices taken.
+             * @param count The number of keys.
+             * @return true if the buffers hold at least count more keys, false if allocation failed.
+             */
+            static bool Reserve(size_t count)
+            {
+                count += top;
+                if (count <= capacity) return true;
+
+                size_t newCapacity = (capacity == 0) ? 64 : capacity;
+                while (newCapacity < count)
+                {
+                    newCapacity = (newCapacity * 2) - (newCapacity / 2);
+                }
+
+                uint32_t* newKeys = static_cast<uint32_t*>(realloc(keys, sizeof(uint32_t) * newCapacity));
+                if (newKeys) keys = newKeys;
+                uint32_t* newScratch = static_cast<uint32_t*>(realloc(scratch, sizeof(uint32_t) * newCapacity));
+                if (newScratch) scratch = newScratch;
+
+                if (!newKeys || !newScratch) return false;
+
+                capacity = newCapacity;
+                return true;
+            }
+
+            /**
+             * @brief Sort keys with a least significant digit radix sort.
+             * @param keys The keys.
+             * @param scratch Room for as many keys, used as the other half of each pass.
+             * @param count The number of keys.
+             * @param varyingBits Bits that differ between keys, digits without any are already sorted and skipped.
+             * @return The sorted keys, either keys or scratch.
+             */
+            static const uint32_t* RadixSort(uint32_t* keys, uint32_t* scratch, size_t count, uint32_t varyingBits)
+            {
+                uint32_t* source = keys;
+                uint32_t* destination = scratch;
+
+                for (size_t shift = 0; shift < sizeof(uint32_t) * CHAR_BIT; shift += RadixBits)
+                {
+                    if (!((varyingBits >> shift) & (RadixSize - 1))) continue;
+
+                    uint32_t offsets[RadixSize] = {};
+                    for (size_t i = 0; i < count; i++)
+                    {
+                        offsets[(source[i] >> shift) & (RadixSize - 1)]++;
+                    }
+
+                    uint32_t sum = 0;
+                    for (size_t digit = 0; digit < RadixSize; digit++)
+                    {
+                        const uint32_t digitCount = offsets[digit];
+                        offsets[digit] = sum;
+                        sum += digitCount;
+                    }
+
+                    for (size_t i = 0; i < count; i++)
+                    {
+                        destination[offsets[(source[i] >> shift) & (RadixSize - 1)]++] = source[i];
+                    }
+
+                    uint32_t* swap = source;
+                    source = destination;
+                    destination = swap;
+                }
+
+                return source;
+            }
         };
     };
 };
@@ -32,6 +32,8 @@ private:
     Fxp farHeight;      /**< Height of the far plane. */
 
 public:
+    static constexpr size_t PlaneCount = PLANE_COUNT;    /**< Number of planes bounding the frustum. */
+
     /**
      * @brief Constructor to initialize the frustum.
      * @param verticalFov Vertical field of view.
@@ -40,10 +42,10 @@ public:
      * @param farDistance Far clipping plane distance.
      */
     Frustum(const Fxp& verticalFov, const Fxp& ratio, const Fxp& nearDistance, const Fxp& farDistance)
-        : farHeight(Trigonometry::Tan(verticalFov)),
-        farWidth(farHeight* ratio),
-        nearDistance(nearDistance),
-        farDistance(farDistance)
+        : nearDistance(nearDistance),
+        farDistance(farDistance),
+        farWidth(Trigonometry::Tan(verticalFov) * ratio),
+        farHeight(Trigonometry::Tan(verticalFov))
     {
     }
 
@@ -59,7 +61,7 @@ public:
     {
         Vec3 farCentre(position + zAxis);
         Vec3 farHalfHeight(yAxis * farHeight);
-        Vec3 farHalfWidth(yAxis * farWidth);
+        Vec3 farHalfWidth(xAxis * farWidth);
 
         Vec3 farTop(farCentre + farHalfHeight);
         Vec3 farTopLeft(farTop - farHalfWidth);
@@ -71,10 +73,11 @@ public:
 
         plane[PLANE_NEAR] = Plane3D(-zAxis, position + zAxis * nearDistance);
         plane[PLANE_FAR] = Plane3D(zAxis, position + zAxis * farDistance);
-        plane[PLANE_TOP] = Plane3D(farTopRight, position, farTopLeft);
-        plane[PLANE_BOTTOM] = Plane3D(farBottomLeft, position, farBottomRight);
-        plane[PLANE_LEFT] = Plane3D(farTopLeft, position, farBottomLeft);
-        plane[PLANE_RIGHT] = Plane3D(farBottomRight, position, farTopRight);
+        // Side normals point outwards, like the near and far ones
+        plane[PLANE_TOP] = Plane3D(farTopLeft, position, farTopRight);
+        plane[PLANE_BOTTOM] = Plane3D(farBottomRight, position, farBottomLeft);
+        plane[PLANE_LEFT] = Plane3D(farBottomLeft, position, farTopLeft);
+        plane[PLANE_RIGHT] = Plane3D(farTopRight, position, farBottomRight);
     }
 
 
@@ -99,6 +102,16 @@ public:
         // Add any additional logic specific to this overload, if needed
     }
 
+    /**
+     * @brief Get one of the planes bounding the frustum, their normals point outwards.
+     * @param index The plane index, lower than PlaneCount.
+     * @return The plane.
+     */
+    const Plane3D& GetPlane(size_t index) const
+    {
+        return plane[index];
+    }
+
     /**
      * @brief Check if a point is inside the frustum.
      * @param position The point to check.
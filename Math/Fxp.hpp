@@ -12,25 +12,20 @@ class Fxp
 private:
     int32_t value; /**< The internal value. */
 
+#ifdef HYPERION_HOST
+    /* Host builds emulate the division unit with a 64-bit division */
+    static inline int32_t dvdntl = 0;
+#else
     /* Division related variables */
     static inline constexpr size_t cpuAddress = 0xFFFFF000UL;
     static inline auto& dvsr = *reinterpret_cast<volatile uint32_t*>(cpuAddress + 0x0F00UL);
     static inline auto& dvdnth = *reinterpret_cast<volatile uint32_t*>(cpuAddress + 0x0F10UL);
     static inline auto& dvdntl = *reinterpret_cast<volatile uint32_t*>(cpuAddress + 0x0F14UL);
+#endif
 
     friend class Vec3;
     friend class Trigonometry;
 
-    struct Internal
-    {
-        int16_t high;
-        uint16_t low;
-        constexpr Internal(const int16_t& highVal, const uint16_t& lowVal = 0) : high(highVal), low(lowVal) {}
-        constexpr Fxp& AsFxp() { return *reinterpret_cast<Fxp*>(this); }
-    };
-
-    constexpr Internal& InternalAccess() { return *reinterpret_cast<Internal*>(value); };
-
     /**
      * @brief Private constructor for creating Fxp objects from an int32_t value.
      * @param inValue The int32_t value to store.
@@ -84,7 +79,7 @@ public:
      * @param integerValue The 16-bit integer value.
      * @return The corresponding Fxp object.
      */
-    static constexpr Fxp FromInt(const int16_t& integerValue) { return Internal(integerValue).AsFxp(); }
+    static constexpr Fxp FromInt(const int16_t& integerValue) { return static_cast<int32_t>(static_cast<uint32_t>(integerValue) << 16); }
 
     /**
      * @brief Build an Fxp object from a raw 32-bit integer value.
@@ -101,6 +96,9 @@ public:
      */
     static void AsyncDivSet(const Fxp& dividend, const Fxp& divisor)
     {
+#ifdef HYPERION_HOST
+        dvdntl = static_cast<int32_t>((static_cast<int64_t>(dividend.value) * 65536) / divisor.value);
+#else
         uint32_t dividendh;
         __asm__ volatile("swap.w %[in], %[out]\n"
             : [out] "=&r"(dividendh)
@@ -112,6 +110,7 @@ public:
         dvdnth = dividendh;
         dvsr = divisor.value;
         dvdntl = dividend.value << 16;
+#endif
     }
 
     /**
@@ -230,7 +229,7 @@ public:
      * @brief Convert the fixed-point value to a 16-bit integer value.
      * @return The 16-bit integer representation of the value.
      */
-    constexpr int16_t ToInt() { return InternalAccess().high; }
+    constexpr int16_t ToInt() { return static_cast<int16_t>(value >> 16); }
 
     /**************Operators****************/
 
@@ -263,6 +262,9 @@ public:
         }
         else
         {
+#ifdef HYPERION_HOST
+            value = static_cast<int32_t>((static_cast<int64_t>(value) * fxp.value) >> 16);
+#else
             uint32_t mach;
             __asm__ volatile(
                 "\tdmuls.l %[a], %[b]\n"
@@ -276,6 +278,7 @@ public:
                 : [a] "r" (value),
                 [b] "r" (fxp.value)
                 : "mach", "macl");
+#endif
         }
 
         return *this;
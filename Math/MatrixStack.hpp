@@ -3,7 +3,7 @@
 #include "Mat43.hpp"
 
 
-#include "..\Utils\std\vector.h"
+#include "../Utils/std/vector.h"
 
 class MatrixStack
 {
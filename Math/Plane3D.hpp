@@ -1,6 +1,6 @@
 #pragma once
 
-#include "..\Math\Vec3.hpp"
+#include "../Math/Vec3.hpp"
 
 /**
  * @brief Represents a 3D plane.
@@ -31,7 +31,7 @@ public:
      */
     Plane3D(const Vec3& vertexA, const Vec3& vertexB, const Vec3& vertexC)
     {
-        normal = Vec3::CalcNormal(vertexA, vertexB, vertexC);
+        normal = Vec3::CalcNormal(vertexA, vertexB, vertexC).Normalize();
         d = normal.Dot(vertexB);
     }
 
@@ -1,7 +1,7 @@
 #pragma once
 
-#include "..\Math\Fxp.hpp"
-#include "..\Utils\std\type_traits.h"
+#include "../Math/Fxp.hpp"
+#include "../Utils/std/type_traits.h"
 
 class Trigonometry
 {
@@ -103,6 +103,12 @@ struct Vec3
         }
         else
         {
+#ifdef HYPERION_HOST
+            const int64_t sum = static_cast<int64_t>(x.value) * vec.x.value +
+                static_cast<int64_t>(y.value) * vec.y.value +
+                static_cast<int64_t>(z.value) * vec.z.value;
+            return static_cast<int32_t>(sum >> 16);
+#else
             int32_t aux0;
             int32_t aux1;
             auto a = reinterpret_cast<const int32_t*>(this);
@@ -123,6 +129,7 @@ struct Vec3
                 "m"(*b)
                 : "mach", "macl", "memory");
             return aux1;
+#endif
         }
     }
 
@@ -204,7 +211,7 @@ struct Vec3
     {
         Fxp length = Length();
         if (length != 0.0F)
-            return Vec3(length / x, length / y, length / z);
+            return Vec3(x / length, y / length, z / length);
         else
             return Vec3();
     }
@@ -218,7 +225,7 @@ struct Vec3
     {
         Fxp length = FastLength();
         if (length != 0.0F)
-            return Vec3(length / x, length / y, length / z);
+            return Vec3(x / length, y / length, z / length);
         else
             return Vec3();
     }
@@ -232,7 +239,7 @@ struct Vec3
     {
         Fxp length = TurboLength();
         if (length != 0.0F)
-            return Vec3(length / x, length / y, length / z);
+            return Vec3(x / length, y / length, z / length);
         else
             return Vec3();
     }
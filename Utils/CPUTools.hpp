@@ -9,13 +9,24 @@ enum CPUType
     Count
 };
 
-CPUType GetCPU()
+#ifdef HYPERION_HOST
+/* Host builds run the work of each CPU on a thread, which sets the CPU it stands for */
+inline thread_local CPUType hostCPU = Master;
+
+inline CPUType GetCPU() { return hostCPU; }
+
+/* Host caches are coherent, there is no cache-through mirror */
+template <typename T>
+volatile T &NoCache(T &value) { return value; }
+#else
+inline CPUType GetCPU()
 {
     return cpu_dual_executor_get() == CPU_MASTER ? Master : Slave;
 }
 
 template <typename T>
 volatile T &NoCache(T &value) { return *((T *)((char *)&value + 0x20000000)); }
+#endif
 
 class Mutex
 {
@@ -0,0 +1,179 @@
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+#include "CPUTools.hpp"
+
+#ifndef HYPERION_EVENT_CHANNEL_SLOTS
+/**
+ * @brief Number of events an EventChannel holds before its producer has to wait, must be a power of two.
+ */
+#define HYPERION_EVENT_CHANNEL_SLOTS 64
+#endif
+
+#ifndef HYPERION_EVENT_CHANNEL_PAYLOAD
+/**
+ * @brief Largest event in bytes an EventChannel carries, must be a multiple of 4.
+ */
+#define HYPERION_EVENT_CHANNEL_PAYLOAD 28
+#endif
+
+/**
+ * @brief Lock-free ring carrying events from one CPU to the other, one producer and one consumer.
+ *
+ * The producer only writes the tail and the consumer only writes the head, so neither ever waits
+ * for the other. Both indices count up forever and wrap around with uint32_t arithmetic, the slot
+ * of an index being its low bits. On the Saturn both CPUs read the shared fields through the
+ * cache-through mirror, their caches are not kept coherent. Host builds use the compiler atomic
+ * builtins instead, as the producer and consumer run on threads.
+ */
+class EventChannel
+{
+public:
+    static constexpr size_t capacity = HYPERION_EVENT_CHANNEL_SLOTS;
+    static constexpr size_t payloadSize = HYPERION_EVENT_CHANNEL_PAYLOAD;
+
+    static_assert((capacity & (capacity - 1)) == 0, "HYPERION_EVENT_CHANNEL_SLOTS must be a power of two");
+    static_assert(payloadSize % sizeof(uint32_t) == 0, "HYPERION_EVENT_CHANNEL_PAYLOAD must be a multiple of 4");
+
+    struct Slot
+    {
+        uint32_t eventTypeId;
+        uint32_t data[payloadSize / sizeof(uint32_t)];
+    };
+
+private:
+#ifdef HYPERION_HOST
+    static constexpr size_t cacheLine = 64;
+#else
+    static constexpr size_t cacheLine = 16;
+#endif
+
+    /* Each index gets its own cache line, so the CPUs do not write to the same line */
+    alignas(cacheLine) uint32_t head = 0;   /**< Next slot to read, written by the consumer. */
+    alignas(cacheLine) uint32_t tail = 0;   /**< Next slot to write, written by the producer. */
+    alignas(cacheLine) Slot slots[capacity];
+
+    /**
+     * @brief Read the index the calling side writes itself.
+     * Its stores go through the cache-through mirror, which does not update the cache of the writer,
+     * so on the Saturn the index is read back through the mirror as well.
+     */
+    static uint32_t LoadOwned(uint32_t &index)
+    {
+#ifdef HYPERION_HOST
+        return __atomic_load_n(&index, __ATOMIC_RELAXED);
+#else
+        return NoCache(index);
+#endif
+    }
+
+    static uint32_t LoadAcquire(uint32_t &index)
+    {
+#ifdef HYPERION_HOST
+        return __atomic_load_n(&index, __ATOMIC_ACQUIRE);
+#else
+        const uint32_t value = NoCache(index);
+        __asm__ volatile("" ::: "memory");
+        return value;
+#endif
+    }
+
+    static void StoreRelease(uint32_t &index, uint32_t value)
+    {
+#ifdef HYPERION_HOST
+        __atomic_store_n(&index, value, __ATOMIC_RELEASE);
+#else
+        __asm__ volatile("" ::: "memory");
+        NoCache(index) = value;
+#endif
+    }
+
+    static void WriteSlot(Slot &to, const Slot &from)
+    {
+#ifdef HYPERION_HOST
+        memcpy(&to, &from, sizeof(Slot));
+#else
+        const size_t words = sizeof(Slot) / sizeof(uint32_t);
+        volatile uint32_t *destination = &NoCache(*(uint32_t *)&to);
+        for (size_t i = 0; i < words; i++)
+        {
+            destination[i] = ((const uint32_t *)&from)[i];
+        }
+#endif
+    }
+
+    static void ReadSlot(Slot &to, Slot &from)
+    {
+#ifdef HYPERION_HOST
+        memcpy(&to, &from, sizeof(Slot));
+#else
+        /* The consumer cache may still hold the slot as it was a lap ago, so read it from memory */
+        const size_t words = sizeof(Slot) / sizeof(uint32_t);
+        volatile uint32_t *source = &NoCache(*(uint32_t *)&from);
+        for (size_t i = 0; i < words; i++)
+        {
+            ((uint32_t *)&to)[i] = source[i];
+        }
+#endif
+    }
+
+public:
+    EventChannel() {}
+
+    EventChannel(const EventChannel &) = delete;
+    EventChannel &operator=(const EventChannel &) = delete;
+
+    /**
+     * @brief Send an event, only called by the producer.
+     * @param eventTypeId Type of the event.
+     * @param data The event, may be nullptr if size is 0.
+     * @param size Size of the event, at most payloadSize.
+     * @return false if the channel is full, the consumer has to drain it first.
+     */
+    bool Push(uint32_t eventTypeId, const void *data, size_t size)
+    {
+        const uint32_t position = LoadOwned(tail);
+        if (position - LoadAcquire(head) >= capacity)
+            return false;
+
+        Slot slot;
+        slot.eventTypeId = eventTypeId;
+        if (size)
+            memcpy(slot.data, data, size);
+        WriteSlot(slots[position & (capacity - 1)], slot);
+
+        StoreRelease(tail, position + 1);
+        return true;
+    }
+
+    /**
+     * @brief Receive every event sent so far, only called by the consumer.
+     * Each slot is copied out and handed back to the producer before the handler runs, so the
+     * producer can refill the channel while the events are handled.
+     * @param handler Called as handler(eventTypeId, data) for each event, in the order they were sent.
+     * @return The number of events received.
+     */
+    template <typename Handler>
+    size_t Drain(Handler &&handler)
+    {
+        const uint32_t first = LoadOwned(head);
+        const uint32_t last = LoadAcquire(tail);
+
+        for (uint32_t position = first; position != last; position++)
+        {
+            Slot slot;
+            ReadSlot(slot, slots[position & (capacity - 1)]);
+            StoreRelease(head, position + 1);
+            handler(slot.eventTypeId, (const void *)slot.data);
+        }
+        return last - first;
+    }
+
+    /**
+     * @brief Check for events waiting, from either CPU.
+     */
+    bool Empty() { return LoadAcquire(head) == LoadAcquire(tail); }
+};
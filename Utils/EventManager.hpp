@@ -1,11 +1,15 @@
+#pragma once
+
+#include <assert.h>
+
 #include "std/type_traits.h"
 #include "SatAlloc.hpp"
-
-constexpr size_t eventQueueSize = 64;
-constexpr size_t maxEventDataSize = 32;
+#include "EventChannel.hpp"
+#include "TimingWheel.hpp"
+#include "Timer.hpp"
 
 template <typename E>
-concept Event = std::is_trivial<E>::value && (sizeof(E) < maxEventDataSize);
+concept Event = std::is_trivial<E>::value;
 
 class EventManager
 {
@@ -15,111 +19,486 @@ public:
 
     using EmptyEventListener = void (*)();
 
+    /**
+     * @brief Listener receiving every queued event of a type at once, as a contiguous array.
+     */
+    template <Event E>
+    using BatchEventListener = void (*)(const E *events, size_t count);
+
+    /**
+     * @brief Order in which the listeners of an event type are called, resolved when they are added.
+     */
+    enum class ListenerPriority : uint8_t
+    {
+        First,
+        High,
+        Normal,
+        Low,
+        Last
+    };
+
+    /**
+     * @brief Subscription of a listener, used to remove it.
+     */
+    struct ListenerHandle
+    {
+        int eventTypeId = -1;
+        uint16_t slot = 0;
+        uint16_t version = 0;
+    };
+
 private:
+    static constexpr size_t priorityCount = static_cast<size_t>(ListenerPriority::Last) + 1;
+    static constexpr uint16_t noHandle = 0xFFFF;
+
+    struct Listener
+    {
+        void *callback;             /**< nullptr once removed while its type is dispatched. */
+        bool batch;
+        uint8_t priority;
+        uint16_t handle;            /**< Handle slot pointing back at the listener. */
+    };
+
+    /**
+     * @brief Handle slot: position of a listener, or next free slot once the listener is removed.
+     */
+    struct HandleSlot
+    {
+        uint16_t index;
+        uint16_t version;
+    };
+
+    /**
+     * @brief Listeners and queue of one event type.
+     *
+     * Queued events are stored contiguously per type in two buffers: events queued while the
+     * current ones are dispatched go to the other buffer, so listeners may queue events freely.
+     */
     struct EventTypeListener
     {
-        bool isEmpty;
+        /* Listeners are sorted by priority, each priority being a run of the array ending at runEnd */
         size_t listenerCount;
-        void **listeners;
+        size_t listenerCapacity;
+        Listener *listeners;
+        size_t runEnd[priorityCount];
+        size_t staged;              /**< Listeners added while dispatching, kept after listenerCount until it ends. */
+        size_t removed;             /**< Listeners removed while dispatching, left in place until it ends. */
+        size_t dispatching;         /**< Depth of the dispatches of this type in progress. */
 
-        void Init(bool isEmpty)
+        HandleSlot *handles;
+        size_t handleCapacity;
+        uint16_t freeHandle;
+
+        void (*dispatch)(size_t eventTypeId, const void *events, size_t count);
+        void (*call)(size_t eventTypeId, const void *events, size_t count);    /**< Dispatch leaving the listener state untouched. */
+        size_t eventSize;
+        char *queued;               /**< Events waiting for ProcessQueuedEvents. */
+        size_t queuedCount;
+        size_t queuedCapacity;
+        char *spare;                /**< Buffer of the events being dispatched. */
+        size_t spareCapacity;
+        bool pending;               /**< Listed in pendingTypes. */
+
+        void Init(void (*dispatch)(size_t, const void *, size_t), void (*call)(size_t, const void *, size_t), size_t eventSize)
         {
-            this->isEmpty = isEmpty;
             listenerCount = 0;
+            listenerCapacity = 0;
             listeners = nullptr;
+            for (size_t priority = 0; priority < priorityCount; priority++)
+            {
+                runEnd[priority] = 0;
+            }
+            staged = 0;
+            removed = 0;
+            dispatching = 0;
+            handles = nullptr;
+            handleCapacity = 0;
+            freeHandle = noHandle;
+            this->dispatch = dispatch;
+            this->call = call;
+            this->eventSize = eventSize;
+            queued = nullptr;
+            queuedCount = 0;
+            queuedCapacity = 0;
+            spare = nullptr;
+            spareCapacity = 0;
+            pending = false;
+        }
+
+        /**
+         * @brief Store a listener at a position, pointing its handle at it.
+         */
+        void Move(size_t to, const Listener &listener)
+        {
+            listeners[to] = listener;
+            if (listener.handle != noHandle)
+                handles[listener.handle].index = static_cast<uint16_t>(to);
+        }
+
+        /**
+         * @brief Insert the listener at listenerCount in its priority run.
+         * The first listener of each lower priority run moves to the end of its run, so an insert
+         * moves one listener per priority instead of shifting the array.
+         */
+        void Insert()
+        {
+            const Listener listener = listeners[listenerCount];
+            size_t hole = listenerCount;
+            for (size_t priority = priorityCount - 1; priority > listener.priority; priority--)
+            {
+                const size_t start = runEnd[priority - 1];
+                if (start != runEnd[priority])
+                {
+                    Move(hole, listeners[start]);
+                    hole = start;
+                }
+                runEnd[priority]++;
+            }
+            runEnd[listener.priority]++;
+            Move(hole, listener);
+            listenerCount++;
+        }
+
+        /**
+         * @brief Remove the listener at a position, swapping the last listener of its priority run in.
+         * The hole left at the end of the run is filled the same way by each lower priority run.
+         */
+        void Erase(size_t index)
+        {
+            size_t hole = index;
+            for (size_t priority = listeners[index].priority; priority < priorityCount; priority++)
+            {
+                /* An empty run ends at the hole, its last position is the hole itself */
+                const size_t last = runEnd[priority] - 1;
+                if (last != hole)
+                {
+                    Move(hole, listeners[last]);
+                }
+                runEnd[priority]--;
+                hole = last;
+            }
+            listenerCount--;
+        }
+
+        /**
+         * @brief Sort in the listeners added and drop the ones removed while dispatching.
+         */
+        void Settle()
+        {
+            for (; staged; staged--)
+            {
+                Insert();
+            }
+
+            for (size_t index = listenerCount; removed && index-- > 0;)
+            {
+                if (!listeners[index].callback)
+                {
+                    Erase(index);
+                    removed--;
+                }
+            }
+        }
+
+        /**
+         * @brief Add a listener, arrays grow geometrically.
+         * @return The handle slot of the listener, or noHandle if memory ran out.
+         */
+        uint16_t AddListener(void *callback, bool batch, ListenerPriority priority)
+        {
+            const size_t count = listenerCount + staged;
+            if (count >= listenerCapacity)
+            {
+                const size_t newCapacity = (listenerCapacity == 0) ? 4 : listenerCapacity * 2;
+                Listener *newListeners = (Listener *)lwram::realloc(listeners, newCapacity * sizeof(Listener));
+                if (!newListeners)
+                    return noHandle;
+
+                listeners = newListeners;
+                listenerCapacity = newCapacity;
+            }
+
+            if (freeHandle == noHandle)
+            {
+                const size_t newCapacity = (handleCapacity == 0) ? 4 : handleCapacity * 2;
+                if (newCapacity > noHandle)
+                    return noHandle;
+
+                HandleSlot *newHandles = (HandleSlot *)lwram::realloc(handles, newCapacity * sizeof(HandleSlot));
+                if (!newHandles)
+                    return noHandle;
+
+                for (size_t slot = newCapacity; slot-- > handleCapacity;)
+                {
+                    newHandles[slot] = {freeHandle, 0};
+                    freeHandle = static_cast<uint16_t>(slot);
+                }
+                handles = newHandles;
+                handleCapacity = newCapacity;
+            }
+
+            const uint16_t handle = freeHandle;
+            freeHandle = handles[handle].index;
+            handles[handle].index = static_cast<uint16_t>(count);
+            listeners[count] = {callback, batch, static_cast<uint8_t>(priority), handle};
+
+            /* The dispatch in progress keeps its order, the listener joins once it ends */
+            if (dispatching)
+                staged++;
+            else
+                Insert();
+
+            return handle;
+        }
+
+        /**
+         * @brief Remove a listener.
+         * @return false if the handle was already removed.
+         */
+        bool RemoveListener(uint16_t handle, uint16_t version)
+        {
+            if (handle >= handleCapacity || handles[handle].version != version)
+                return false;
+
+            const size_t index = handles[handle].index;
+            handles[handle] = {freeHandle, static_cast<uint16_t>(version + 1)};
+            freeHandle = handle;
+
+            if (dispatching)
+            {
+                listeners[index].callback = nullptr;
+                listeners[index].handle = noHandle;
+                removed++;
+            }
+            else
+            {
+                Erase(index);
+            }
+            return true;
         }
 
-        void AddListener(void *callback)
+        /**
+         * @brief Make room for one more queued event, growing the queue geometrically.
+         * @param slot Receives where to store the event.
+         * @return true if queued, false if memory ran out.
+         */
+        bool Push(void *&slot)
         {
-            size_t pos = listenerCount++;
+            if (queuedCount >= queuedCapacity)
+            {
+                const size_t newCapacity = (queuedCapacity == 0) ? 16 : (queuedCapacity * 2) - (queuedCapacity / 2);
 
-            listeners = (void **)lwram::realloc(listeners, listenerCount * sizeof(void *));
-            listeners[pos] = callback;
+                /* Empty events only count, they store nothing */
+                if (eventSize)
+                {
+                    char *newQueued = (char *)lwram::realloc(queued, newCapacity * eventSize);
+                    if (!newQueued)
+                        return false;
+
+                    queued = newQueued;
+                }
+                queuedCapacity = newCapacity;
+            }
+
+            slot = queued + (queuedCount++ * eventSize);
+            return true;
         }
     };
 
     static inline EventTypeListener *eventTypeListeners = nullptr;
     static inline int eventTypeCounter = 0;
 
+    static inline int *pendingTypes = nullptr;      /**< Types with queued events, in order of their first event. */
+    static inline size_t pendingCount = 0;
+    static inline size_t pendingCapacity = 0;
+
+    /**
+     * @brief Call the listeners of a type without writing to its listener state, so the slave CPU
+     * can call them while the master CPU dispatches the same type.
+     */
+    template <Event E>
+    static void Call(size_t eventTypeId, const void *events, size_t count)
+    {
+        /* The type array is read on each iteration, listeners may add event types while dispatching */
+        for (size_t i = 0; i < eventTypeListeners[eventTypeId].listenerCount; i++)
+        {
+            const Listener listener = eventTypeListeners[eventTypeId].listeners[i];
+            /* Removed while dispatching */
+            if (!listener.callback)
+                continue;
+
+            if constexpr (std::is_empty_v<E>)
+            {
+                for (size_t j = 0; j < count; j++)
+                {
+                    ((EmptyEventListener)listener.callback)();
+                }
+            }
+            else if (listener.batch)
+            {
+                ((BatchEventListener<E>)listener.callback)((const E *)events, count);
+            }
+            else
+            {
+                for (size_t j = 0; j < count; j++)
+                {
+                    ((EventListener<E>)listener.callback)((E *)events + j);
+                }
+            }
+        }
+    }
+
+    template <Event E>
+    static void Dispatch(size_t eventTypeId, const void *events, size_t count)
+    {
+        eventTypeListeners[eventTypeId].dispatching++;
+        Call<E>(eventTypeId, events, count);
+
+        EventTypeListener &type = eventTypeListeners[eventTypeId];
+        if (--type.dispatching == 0 && (type.staged || type.removed))
+            type.Settle();
+    }
+
+    static ListenerHandle AddListener(int eventTypeId, void *callback, bool batch, ListenerPriority priority)
+    {
+        const uint16_t slot = eventTypeListeners[eventTypeId].AddListener(callback, batch, priority);
+        if (slot == noHandle)
+            return ListenerHandle();
+
+        return {eventTypeId, slot, eventTypeListeners[eventTypeId].handles[slot].version};
+    }
+
     template <Event E>
     static int AddEventType()
     {
         size_t eventId = eventTypeCounter++;
 
-        
         eventTypeListeners = (EventTypeListener *)lwram::realloc(eventTypeListeners, eventTypeCounter * sizeof(EventTypeListener));
-        eventTypeListeners[eventId].Init(std::is_empty_v<E>);
+        eventTypeListeners[eventId].Init(&Dispatch<E>, &Call<E>, std::is_empty_v<E> ? 0 : sizeof(E));
         return eventId;
     }
 
     template <Event E>
     static inline const int EventId = AddEventType<E>();
 
-    struct QueuedEvent
-    {
-        int eventTypeId;
-        char eventData[maxEventDataSize];
-    };
+    /* Events sent to each CPU by the other one */
+    static inline EventChannel channels[CPUType::Count];
 
-    static inline QueuedEvent eventQueue[eventQueueSize] = {0};
-    static inline size_t lastPosition = 0;
+    static inline TimingWheel timedEvents;
 
-    static void TriggerEvent(size_t eventTypeId, void *eventData)
+    /**
+     * @brief Check that a CPU queueing an event for itself owns the local queues, only the master CPU does.
+     */
+    static bool IsLocalQueueOwner(CPUType cpu)
     {
-        using Listener = void (*)(void *);
-        for (size_t i = 0; i < eventTypeListeners[eventTypeId].listenerCount; i++)
-        {
-            ((Listener)eventTypeListeners[eventTypeId].listeners[i])(eventData);
-        }
+        assert(cpu == CPUType::Master && "The slave CPU has no local queue, its events come through the channel");
+        return cpu == CPUType::Master;
     }
 
-    static void TriggerEvent(size_t eventTypeId)
+    /**
+     * @brief Reserve a queue slot for an event, listing its type as pending on its first event.
+     * @param slot Receives where to store the event.
+     * @return true if queued, false if memory ran out.
+     */
+    static bool QueueSlot(int eventTypeId, void *&slot)
     {
-        for (size_t i = 0; i < eventTypeListeners[eventTypeId].listenerCount; i++)
+        EventTypeListener &type = eventTypeListeners[eventTypeId];
+        if (!type.pending && pendingCount >= pendingCapacity)
+        {
+            const size_t newCapacity = (pendingCapacity == 0) ? 8 : pendingCapacity * 2;
+            int *newPending = (int *)lwram::realloc(pendingTypes, newCapacity * sizeof(int));
+            if (!newPending)
+                return false;
+
+            pendingTypes = newPending;
+            pendingCapacity = newCapacity;
+        }
+
+        /* A type is listed once it holds an event, so listeners are never called with none */
+        if (!type.Push(slot))
+            return false;
+
+        if (!type.pending)
         {
-            ((EmptyEventListener)eventTypeListeners[eventTypeId].listeners[i])();
+            pendingTypes[pendingCount++] = eventTypeId;
+            type.pending = true;
         }
+        return true;
     }
 
 public:
+    /**
+     * @brief Add a listener called with each event of a type.
+     * Listeners are called from the first priority to the last, the order among listeners of the
+     * same priority is not set. A listener added while its type is dispatched misses that dispatch.
+     * @return The handle to remove the listener with, invalid if memory ran out.
+     */
     template <Event E>
-    static void AddListener(EventListener<E> listener)
+    static ListenerHandle AddListener(EventListener<E> listener, ListenerPriority priority = ListenerPriority::Normal)
     {
-        eventTypeListeners[EventId<E>].AddListener((void *)listener);
+        return AddListener(EventId<E>, (void *)listener, false, priority);
     }
 
     template <Event E>
-    static void AddListener(EmptyEventListener listener)
+    static ListenerHandle AddListener(EmptyEventListener listener, ListenerPriority priority = ListenerPriority::Normal)
+    {
+        return AddListener(EventId<E>, (void *)listener, false, priority);
+    }
+
+    /**
+     * @brief Add a listener called once per ProcessQueuedEvents with all the queued events of a type.
+     * Events triggered immediately are passed as a batch of one.
+     * @return The handle to remove the listener with, invalid if memory ran out.
+     */
+    template <Event E>
+        requires(!std::is_empty_v<E>)
+    static ListenerHandle AddListener(BatchEventListener<E> listener, ListenerPriority priority = ListenerPriority::Normal)
+    {
+        return AddListener(EventId<E>, (void *)listener, true, priority);
+    }
+
+    /**
+     * @brief Remove a listener in constant time. A listener removed while its type is dispatched
+     * is skipped by the rest of that dispatch, once it is done with the events it was handed.
+     * @return false if the handle is invalid or the listener was removed already.
+     */
+    static bool RemoveListener(ListenerHandle &handle)
     {
-        eventTypeListeners[EventId<E>].AddListener((void *)listener);
+        if (handle.eventTypeId < 0 || handle.eventTypeId >= eventTypeCounter)
+            return false;
+
+        const bool removed = eventTypeListeners[handle.eventTypeId].RemoveListener(handle.slot, handle.version);
+        handle = ListenerHandle();
+        return removed;
     }
 
     template <Event E>
         requires(!std::is_empty_v<E>)
     static void TriggerEvent(const E &ev)
     {
-        TriggerEvent(EventId<E>, (void *)&ev);
+        Dispatch<E>(EventId<E>, &ev, 1);
     }
 
     template <Event E>
         requires std::is_empty_v<E>
     static void TriggerEvent()
     {
-        TriggerEvent((size_t)EventId<E>);
+        Dispatch<E>(EventId<E>, nullptr, 1);
     }
 
+    /**
+     * @brief Queue an event until the next ProcessQueuedEvents, queues grow as needed.
+     * @return false only if memory ran out.
+     */
     template <Event E>
         requires(!std::is_empty_v<E>)
     static bool QueueEvent(const E &ev)
     {
-        if (lastPosition >= eventQueueSize)
+        void *slot;
+        if (!QueueSlot(EventId<E>, slot))
             return false;
 
-        eventQueue[lastPosition].eventTypeId = EventId<E>;
-        *((E *)eventQueue[lastPosition].eventData) = ev;
-
-        lastPosition++;
-
+        *((E *)slot) = ev;
         return true;
     }
 
@@ -127,26 +506,166 @@ public:
         requires std::is_empty_v<E>
     static bool QueueEvent()
     {
-        if (lastPosition >= eventQueueSize)
-            return false;
+        void *slot;
+        return QueueSlot(EventId<E>, slot);
+    }
+
+    /**
+     * @brief Queue an event to be dispatched on a given CPU.
+     *
+     * Events for the other CPU go through a lock-free channel and are dispatched by its
+     * ProcessChannelEvents. Only the master CPU may use the local queues, and the listeners of the
+     * types sent to the slave CPU must be added before it starts and left unchanged while it runs.
+     * @param cpu The CPU whose listeners receive the event.
+     * @return false if the channel to the other CPU is full, if memory ran out, or if the slave CPU
+     * queued an event for itself, which asserts.
+     */
+    template <Event E>
+        requires(!std::is_empty_v<E>)
+    static bool QueueEvent(const E &ev, CPUType cpu)
+    {
+        static_assert(sizeof(E) <= EventChannel::payloadSize, "Event too large for HYPERION_EVENT_CHANNEL_PAYLOAD");
 
-        eventQueue[lastPosition].eventTypeId = EventId<E>;
-        lastPosition++;
+        if (cpu != GetCPU())
+            return channels[cpu].Push(EventId<E>, &ev, sizeof(E));
 
-        return true;
+        return IsLocalQueueOwner(cpu) && QueueEvent(ev);
+    }
+
+    template <Event E>
+        requires std::is_empty_v<E>
+    static bool QueueEvent(CPUType cpu)
+    {
+        if (cpu != GetCPU())
+            return channels[cpu].Push(EventId<E>, nullptr, 0);
+
+        return IsLocalQueueOwner(cpu) && QueueEvent<E>();
+    }
+
+    /**
+     * @brief Queue an event at a time of SystemTime, the ProcessQueuedEvents call reaching it dispatches it.
+     * Events due at the same time are queued in the order they were scheduled.
+     * @param time When the event is due, in milliseconds. Times already passed are due at once.
+     * @return false only if memory ran out.
+     */
+    template <Event E>
+        requires(!std::is_empty_v<E>)
+    static bool QueueEventAt(uint32_t time, const E &ev)
+    {
+        static_assert(sizeof(E) <= TimingWheel::payloadSize, "Event too large for HYPERION_TIMED_EVENT_PAYLOAD");
+
+        if (!timedEvents.Pending())
+            timedEvents.Skip(SystemTime::CurrentTime());
+
+        return timedEvents.Schedule(time, EventId<E>, &ev, sizeof(E));
+    }
+
+    template <Event E>
+        requires std::is_empty_v<E>
+    static bool QueueEventAt(uint32_t time)
+    {
+        if (!timedEvents.Pending())
+            timedEvents.Skip(SystemTime::CurrentTime());
+
+        return timedEvents.Schedule(time, EventId<E>, nullptr, 0);
+    }
+
+    /**
+     * @brief Queue an event a number of milliseconds from now.
+     * @return false only if memory ran out.
+     */
+    template <Event E>
+        requires(!std::is_empty_v<E>)
+    static bool QueueEventAfter(uint32_t ms, const E &ev)
+    {
+        return QueueEventAt(SystemTime::CurrentTime() + ms, ev);
+    }
+
+    template <Event E>
+        requires std::is_empty_v<E>
+    static bool QueueEventAfter(uint32_t ms)
+    {
+        return QueueEventAt<E>(SystemTime::CurrentTime() + ms);
+    }
+
+    /**
+     * @brief Move the timed events due up to a time to the queues, called by ProcessQueuedEvents.
+     * The cost depends on the number of events due, not on the number of events waiting.
+     * @param now The current time, in milliseconds.
+     * @return false if memory ran out, the events not queued stay scheduled for the next call.
+     */
+    static bool ProcessTimedEvents(uint32_t now)
+    {
+        return timedEvents.Advance(now, [](uint32_t eventTypeId, const void *data)
+                                   {
+                                       void *slot;
+                                       if (!QueueSlot(eventTypeId, slot))
+                                           return false;
+
+                                       if (eventTypeListeners[eventTypeId].eventSize)
+                                           memcpy(slot, data, eventTypeListeners[eventTypeId].eventSize);
+                                       return true;
+                                   });
+    }
+
+    /**
+     * @brief Dispatch the events the other CPU sent to this one, in the order they were sent.
+     * Called by ProcessQueuedEvents, the slave CPU calls it directly.
+     *
+     * The listener state belongs to the master CPU: the slave CPU only reads it, calling the listeners
+     * of each event without the bookkeeping of a dispatch. Listeners of the types sent to the slave
+     * CPU must not be added or removed while it runs.
+     * @return The number of events dispatched.
+     */
+    static size_t ProcessChannelEvents()
+    {
+        if (GetCPU() == CPUType::Master)
+            return channels[CPUType::Master].Drain([](uint32_t eventTypeId, const void *data)
+                                                   { eventTypeListeners[eventTypeId].dispatch(eventTypeId, data, 1); });
+
+        return channels[CPUType::Slave].Drain([](uint32_t eventTypeId, const void *data)
+                                              { eventTypeListeners[eventTypeId].call(eventTypeId, data, 1); });
     }
 
+    /**
+     * @brief Dispatch the queued events, type after type in the order each type was first queued.
+     * Events of a type reach each listener in the order they were queued. Events queued by the
+     * listeners are dispatched by this same call. Events sent by the other CPU are dispatched first,
+     * then the timed events due by now are queued.
+     */
     static void ProcessQueuedEvents()
     {
-        for (size_t i = 0; i < lastPosition; i++)
+        ProcessChannelEvents();
+        ProcessTimedEvents(SystemTime::CurrentTime());
+
+        for (size_t i = 0; i < pendingCount; i++)
         {
-            size_t eventTypeId = eventQueue[i].eventTypeId;
+            const size_t eventTypeId = pendingTypes[i];
+            EventTypeListener &type = eventTypeListeners[eventTypeId];
 
-            if (eventTypeListeners[eventTypeId].isEmpty)
-                TriggerEvent(eventTypeId);
-            else
-                TriggerEvent(eventTypeId, eventQueue[i].eventData);
+            /* Swap buffers, events queued by the listeners go to the other one and list the type again */
+            char *events = type.queued;
+            const size_t count = type.queuedCount;
+            type.queued = type.spare;
+            type.spare = events;
+            const size_t capacity = type.queuedCapacity;
+            type.queuedCapacity = type.spareCapacity;
+            type.spareCapacity = capacity;
+            type.queuedCount = 0;
+            type.pending = false;
+
+            eventTypeListeners[eventTypeId].dispatch(eventTypeId, events, count);
+
+            /* Keep filling the dispatched buffer while no listener queued this type, it is the grown one */
+            EventTypeListener &dispatched = eventTypeListeners[eventTypeId];
+            if (!dispatched.pending)
+            {
+                dispatched.spare = dispatched.queued;
+                dispatched.spareCapacity = dispatched.queuedCapacity;
+                dispatched.queued = events;
+                dispatched.queuedCapacity = capacity;
+            }
         }
-        lastPosition = 0;
+        pendingCount = 0;
     }
-};
\ No newline at end of file
+};
@@ -0,0 +1,153 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "SatAlloc.hpp"
+#include "std/type_traits.h"
+
+/**
+ * @brief Bump allocator for data that only lives for a frame or two, carved from one block of a memory region.
+ *
+ * The block is split in two halves used on alternate frames: EndFrame empties the half of the frame
+ * before the last one, so data allocated during a frame stays valid until the end of the next one.
+ * Nothing is freed one by one and no destructor runs, the arena only holds trivially destructible data.
+ * @tparam Region The memory region the block is allocated from.
+ */
+template <MemoryRegion Region = MemoryRegion::LWRAM>
+class FrameArena
+{
+private:
+    struct Half
+    {
+        char *start = nullptr;
+        size_t used = 0;
+    };
+
+    char *block = nullptr;
+    size_t capacity = 0;        /**< Bytes per half. */
+    Half halves[2];
+    size_t current = 0;
+    size_t highWater = 0;       /**< Most bytes used by a frame since the last ResetHighWater. */
+    size_t failed = 0;          /**< Allocations that did not fit since the last ResetHighWater. */
+
+public:
+    FrameArena() {}
+
+    /**
+     * @brief Allocate the arena.
+     * @param bytesPerFrame Bytes available to each frame, the block holds twice as much.
+     */
+    FrameArena(size_t bytesPerFrame) { Initialize(bytesPerFrame); }
+
+    ~FrameArena() { Release(); }
+
+    FrameArena(const FrameArena &) = delete;
+    FrameArena &operator=(const FrameArena &) = delete;
+
+    /**
+     * @brief Allocate the arena block, releasing the previous one.
+     * @param bytesPerFrame Bytes available to each frame, the block holds twice as much.
+     * @return false if the region ran out of memory.
+     */
+    bool Initialize(size_t bytesPerFrame)
+    {
+        Release();
+
+        /* Keep the second half as aligned as the first */
+        bytesPerFrame = (bytesPerFrame + alignof(max_align_t) - 1) & ~(alignof(max_align_t) - 1);
+        block = (char *)region_malloc<Region>(bytesPerFrame * 2);
+        if (!block)
+            return false;
+
+        capacity = bytesPerFrame;
+        halves[0].start = block;
+        halves[1].start = block + bytesPerFrame;
+        return true;
+    }
+
+    void Release()
+    {
+        if (block)
+            region_free<Region>(block);
+
+        block = nullptr;
+        capacity = 0;
+        halves[0] = Half();
+        halves[1] = Half();
+        current = 0;
+    }
+
+    /**
+     * @brief Allocate bytes for the current frame.
+     * @param size Number of bytes.
+     * @param alignment Alignment of the bytes, must be a power of two.
+     * @return The bytes, valid until the end of the next frame, or nullptr if the frame is full.
+     */
+    void *Allocate(size_t size, size_t alignment = alignof(max_align_t))
+    {
+        Half &half = halves[current];
+        const uintptr_t base = reinterpret_cast<uintptr_t>(half.start);
+        const size_t start = ((base + half.used + alignment - 1) & ~static_cast<uintptr_t>(alignment - 1)) - base;
+        if (start > capacity || size > capacity - start)
+        {
+            /* The arena does not grow, failures are counted so it can be sized from them */
+            failed++;
+            return nullptr;
+        }
+
+        half.used = start + size;
+        if (half.used > highWater)
+            highWater = half.used;
+
+        return half.start + start;
+    }
+
+    /**
+     * @brief Allocate an uninitialized array for the current frame.
+     * @tparam T Element type, must be trivially destructible.
+     * @param count Number of elements.
+     * @return The array, valid until the end of the next frame, or nullptr if the frame is full.
+     */
+    template <typename T>
+    T *Allocate(size_t count = 1)
+    {
+        static_assert(std::is_trivially_destructible_v<T>, "Frame arena data is never destroyed");
+        return (T *)Allocate(sizeof(T) * count, alignof(T));
+    }
+
+    /**
+     * @brief End the current frame: the next one allocates in the half of the frame before it, emptied.
+     */
+    void EndFrame()
+    {
+        current ^= 1;
+        halves[current].used = 0;
+    }
+
+    /**
+     * @brief Bytes available to each frame.
+     */
+    size_t Capacity() const { return capacity; }
+
+    /**
+     * @brief Bytes allocated by the current frame, alignment padding included.
+     */
+    size_t Used() const { return halves[current].used; }
+
+    /**
+     * @brief Most bytes allocated by a single frame, to size the arena.
+     */
+    size_t HighWater() const { return highWater; }
+
+    /**
+     * @brief Allocations refused because their frame was full.
+     */
+    size_t Failed() const { return failed; }
+
+    void ResetHighWater()
+    {
+        highWater = halves[current].used;
+        failed = 0;
+    }
+};
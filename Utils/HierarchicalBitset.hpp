@@ -4,6 +4,171 @@
 
 #include <limits.h>
 #include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+/**
+ * @brief Word level bit operations shared by the bitsets.
+ */
+struct BitsetWord
+{
+    static constexpr size_t wordSize = CHAR_BIT * sizeof(size_t);
+
+    /**
+     * @brief Get the position of the lowest set bit of a word.
+     * @param word The word, must not be 0.
+     */
+    static size_t CountTrailingZeros(size_t word)
+    {
+#ifdef HYPERION_HOST
+        return static_cast<size_t>(__builtin_ctzll(word));
+#else
+        if constexpr (wordSize == 32)
+        {
+            /* The SH-2 has no bit scan instruction, isolate the lowest bit and hash it with a de Bruijn multiply */
+            static constexpr uint8_t positions[32] = {
+                0, 1, 28, 2, 29, 14, 24, 3, 30, 22, 20, 15, 25, 17, 4, 8,
+                31, 27, 13, 23, 21, 19, 16, 7, 26, 12, 18, 6, 11, 5, 10, 9};
+            return positions[static_cast<uint32_t>((word & (0 - word)) * 0x077CB531u) >> 27];
+        }
+        else
+        {
+            return PopCount((word & (0 - word)) - 1);
+        }
+#endif
+    }
+
+    /**
+     * @brief Get the number of clear bits above the highest set bit of a word.
+     * @param word The word, must not be 0.
+     */
+    static size_t CountLeadingZeros(size_t word)
+    {
+#ifdef HYPERION_HOST
+        return static_cast<size_t>(__builtin_clzll(word)) - (64 - wordSize);
+#else
+        /* The SH-2 has no bit scan instruction, smear the highest bit down and count the bits it covers */
+        for (size_t shift = 1; shift < wordSize; shift <<= 1)
+        {
+            word |= word >> shift;
+        }
+        return wordSize - PopCount(word);
+#endif
+    }
+
+    /**
+     * @brief Get the number of set bits of a word.
+     */
+    static size_t PopCount(size_t word)
+    {
+#ifdef HYPERION_HOST
+        return static_cast<size_t>(__builtin_popcountll(word));
+#else
+        constexpr size_t ones = ~static_cast<size_t>(0);
+        word = word - ((word >> 1) & (ones / 3));
+        word = (word & (ones / 15 * 3)) + ((word >> 2) & (ones / 15 * 3));
+        word = (word + (word >> 4)) & (ones / 255 * 15);
+        return (word * (ones / 255)) >> ((sizeof(size_t) - 1) * CHAR_BIT);
+#endif
+    }
+
+    /**
+     * @brief Get a mask of the bits of a word from a bit up to the highest one.
+     */
+    static size_t MaskFrom(size_t bit) { return ~static_cast<size_t>(0) << bit; }
+
+    /**
+     * @brief Get a mask of the bits of a word from the lowest one up to a bit included.
+     */
+    static size_t MaskTo(size_t bit) { return ~static_cast<size_t>(0) >> (wordSize - 1 - bit); }
+
+    /**
+     * @brief Combine two word arrays in place, a word at a time.
+     * Host builds combine several words per instruction through GCC vector extensions.
+     * @param words The words to update.
+     * @param others The words to combine them with, may be words itself.
+     * @param count The number of words.
+     * @param op Generic function combining two words, or two vectors of words.
+     */
+    template <typename Op>
+    static void Combine(size_t *words, const size_t *others, size_t count, Op op)
+    {
+        size_t index = 0;
+#ifdef HYPERION_HOST
+        typedef size_t Vector __attribute__((vector_size(16)));
+        for (; index + (sizeof(Vector) / sizeof(size_t)) <= count; index += sizeof(Vector) / sizeof(size_t))
+        {
+            Vector word;
+            Vector other;
+            memcpy(&word, words + index, sizeof(Vector));
+            memcpy(&other, others + index, sizeof(Vector));
+            word = op(word, other);
+            memcpy(words + index, &word, sizeof(Vector));
+        }
+#endif
+        for (; index < count; index++)
+        {
+            words[index] = op(words[index], others[index]);
+        }
+    }
+
+    /**
+     * @brief Check whether two word arrays have a set bit in common.
+     * Words are tested four at a time, so the early out costs a branch per block.
+     */
+    static bool Intersects(const size_t *words, const size_t *others, size_t count)
+    {
+        size_t index = 0;
+        for (; index + 4 <= count; index += 4)
+        {
+            if ((words[index] & others[index]) | (words[index + 1] & others[index + 1]) |
+                (words[index + 2] & others[index + 2]) | (words[index + 3] & others[index + 3]))
+                return true;
+        }
+
+        for (; index < count; index++)
+        {
+            if (words[index] & others[index])
+                return true;
+        }
+        return false;
+    }
+
+    /**
+     * @brief Get a summary word: bit i is set if word i of a span of the level below is not empty.
+     * @param words The first word of the span.
+     * @param count The number of words in the span, at most wordSize.
+     */
+    static size_t Summarize(const size_t *words, size_t count)
+    {
+        size_t summary = 0;
+        for (size_t index = 0; index < count; index++)
+        {
+            summary |= static_cast<size_t>(words[index] != 0) << index;
+        }
+        return summary;
+    }
+
+    /**
+     * @brief Call a lambda with the position of every set bit of a word, lowest first.
+     * @param word The word.
+     * @param base Position of the lowest bit of the word.
+     * @param limit Positions from limit on are not reported.
+     */
+    template <typename Lambda>
+    static void ForEachSet(size_t word, size_t base, size_t limit, Lambda &lambda)
+    {
+        while (word)
+        {
+            const size_t pos = base + CountTrailingZeros(word);
+            if (pos >= limit)
+                return;
+
+            word &= word - 1;
+            lambda(pos);
+        }
+    }
+};
 
 template <size_t capacity>
 class FixedHierarchicalBitset;
@@ -26,6 +191,9 @@ private:
 
     static constexpr bool hasSummary = summarySize != 0;
 
+    template <size_t>
+    friend class FixedHierarchicalBitset;
+
     static size_t CalculateIndex(size_t pos) { return pos / wordSize; }
     static size_t CalculateBitMask(size_t pos)
     {
@@ -53,7 +221,30 @@ private:
 
     bool SummaryLookup(size_t &pos) { return false; }
 
-    bool SummaryGet(size_t pos) { return !hasSummary || summary.Get(pos); }
+    /* Words [first, last) changed, refresh the summary bits covering them */
+    void SummaryWords(size_t first, size_t last)
+    {
+        if constexpr (hasSummary)
+        {
+            summary.SummarizeWords(bitArray, first, last);
+        }
+    }
+
+    /* Recompute the bits [first, last) from the words of the level below */
+    void SummarizeWords(const size_t *words, size_t first, size_t last)
+    {
+        if (first >= last)
+            return;
+
+        const size_t firstIndex = CalculateIndex(first);
+        const size_t lastIndex = CalculateIndex(last - 1) + 1;
+        for (size_t index = firstIndex; index < lastIndex; index++)
+        {
+            const size_t base = index * wordSize;
+            bitArray[index] = BitsetWord::Summarize(words + base, (capacity - base < wordSize) ? capacity - base : wordSize);
+        }
+        SummaryWords(firstIndex, lastIndex);
+    }
 
 public:
     static constexpr size_t GetCapacity() { return capacity; }
@@ -85,49 +276,259 @@ public:
 
     bool Get(size_t pos) const
     {
-        return IsValid(pos) && SummaryGet(pos) &&
+        return IsValid(pos) &&
                (bitArray[CalculateIndex(pos)] & CalculateBitMask(pos));
     }
 
-    bool LookupSetPos(size_t &pos) const
+    /**
+     * @brief Set the bits from first up to last excluded, clamped to the capacity.
+     */
+    void SetRange(size_t first, size_t last)
     {
-        size_t searchIndex = 0;
+        if (last > capacity)
+            last = capacity;
+        if (first >= last)
+            return;
+
+        const size_t firstIndex = CalculateIndex(first);
+        const size_t lastIndex = CalculateIndex(last - 1);
+        const size_t firstMask = BitsetWord::MaskFrom(first % wordSize);
+        const size_t lastMask = BitsetWord::MaskTo((last - 1) % wordSize);
+
+        if (firstIndex == lastIndex)
+        {
+            bitArray[firstIndex] |= firstMask & lastMask;
+        }
+        else
+        {
+            bitArray[firstIndex] |= firstMask;
+            for (size_t index = firstIndex + 1; index < lastIndex; index++)
+            {
+                bitArray[index] = ~static_cast<size_t>(0);
+            }
+            bitArray[lastIndex] |= lastMask;
+        }
+
         if constexpr (hasSummary)
         {
-            if (!summary.LookupSetPos(searchIndex))
-                return false;
+            summary.SetRange(firstIndex, lastIndex + 1);
+        }
+    }
+
+    /**
+     * @brief Clear the bits from first up to last excluded, clamped to the capacity.
+     */
+    void ClearRange(size_t first, size_t last)
+    {
+        if (last > capacity)
+            last = capacity;
+        if (first >= last)
+            return;
+
+        const size_t firstIndex = CalculateIndex(first);
+        const size_t lastIndex = CalculateIndex(last - 1);
+        const size_t firstMask = BitsetWord::MaskFrom(first % wordSize);
+        const size_t lastMask = BitsetWord::MaskTo((last - 1) % wordSize);
+
+        if (firstIndex == lastIndex)
+        {
+            bitArray[firstIndex] &= ~(firstMask & lastMask);
+        }
+        else
+        {
+            bitArray[firstIndex] &= ~firstMask;
+            for (size_t index = firstIndex + 1; index < lastIndex; index++)
+            {
+                bitArray[index] = 0;
+            }
+            bitArray[lastIndex] &= ~lastMask;
+        }
+
+        if constexpr (hasSummary)
+        {
+            summary.ClearRange(firstIndex + 1, lastIndex);
+            SummaryClear(firstIndex);
+            SummaryClear(lastIndex);
+        }
+    }
+
+    /**
+     * @brief Keep only the bits also set in another bitset.
+     */
+    void And(const FixedHierarchicalBitset &other)
+    {
+        BitsetWord::Combine(bitArray, other.bitArray, bitArraySize, [](auto a, auto b) { return a & b; });
+        SummaryWords(0, bitArraySize);
+    }
+
+    /**
+     * @brief Set the bits set in another bitset.
+     */
+    void Or(const FixedHierarchicalBitset &other)
+    {
+        BitsetWord::Combine(bitArray, other.bitArray, bitArraySize, [](auto a, auto b) { return a | b; });
+
+        /* A word is non-empty if it was in either bitset */
+        if constexpr (hasSummary)
+        {
+            summary.Or(other.summary);
         }
+    }
+
+    /**
+     * @brief Clear the bits set in another bitset.
+     */
+    void AndNot(const FixedHierarchicalBitset &other)
+    {
+        BitsetWord::Combine(bitArray, other.bitArray, bitArraySize, [](auto a, auto b) { return a & ~b; });
+        SummaryWords(0, bitArraySize);
+    }
 
-        size_t i = 0;
-        size_t searchWord = bitArray[searchIndex];
+    /**
+     * @brief Flip the bits set in another bitset.
+     */
+    void Xor(const FixedHierarchicalBitset &other)
+    {
+        BitsetWord::Combine(bitArray, other.bitArray, bitArraySize, [](auto a, auto b) { return a ^ b; });
+        SummaryWords(0, bitArraySize);
+    }
 
-        while (searchWord && i < wordSize)
+    /**
+     * @brief Check whether a bit is set in both bitsets.
+     */
+    bool Intersects(const FixedHierarchicalBitset &other) const
+    {
+        return BitsetWord::Intersects(bitArray, other.bitArray, bitArraySize);
+    }
+
+    /**
+     * @brief Find the first set bit at or after a position.
+     * @param pos The position to search from, set to the found bit.
+     * @return true if a set bit was found.
+     */
+    bool FindNext(size_t &pos) const
+    {
+        if (!IsValid(pos))
+            return false;
+
+        size_t index = CalculateIndex(pos);
+        size_t word = bitArray[index] & (~static_cast<size_t>(0) << (pos % wordSize));
+
+        if (!word)
         {
-            if (searchWord & 1)
+            if constexpr (!hasSummary)
             {
-                size_t new_pos = (searchIndex * wordSize) + i;
-                if (new_pos < capacity)
-                {
-                    pos = new_pos;
-                    return true;
-                }
+                return false;
             }
+            else
+            {
+                /* The summary holds a bit per non-empty word */
+                index++;
+                if (!summary.FindNext(index))
+                    return false;
 
-            searchWord >>= 1;
-            ++i;
+                word = bitArray[index];
+            }
         }
 
+        const size_t found = (index * wordSize) + BitsetWord::CountTrailingZeros(word);
+        if (!IsValid(found))
+            return false;
+
+        pos = found;
+        return true;
+    }
+
+    /**
+     * @brief Find the last clear bit before a position, a word at a time.
+     * @param pos The position to search before, set to the found bit.
+     * @return false if every bit before the position is set.
+     */
+    bool FindPreviousClear(size_t &pos) const
+    {
+        if (pos > capacity)
+            pos = capacity;
+
+        for (size_t end = pos; end;)
+        {
+            const size_t index = CalculateIndex(end - 1);
+            const size_t word = ~bitArray[index] & BitsetWord::MaskTo((end - 1) % wordSize);
+            if (word)
+            {
+                pos = (index * wordSize) + (wordSize - 1) - BitsetWord::CountLeadingZeros(word);
+                return true;
+            }
+            end = index * wordSize;
+        }
         return false;
     }
+
+    bool LookupSetPos(size_t &pos) const
+    {
+        size_t found = 0;
+        if (!FindNext(found))
+            return false;
+
+        pos = found;
+        return true;
+    }
+
+    /**
+     * @brief Call a lambda with the position of every set bit, in increasing order.
+     * Empty words are skipped through the summary. The lambda may clear the bits it visits.
+     * @param lambda Function taking the position of a set bit.
+     */
+    template <typename Lambda>
+    void ForEachSet(Lambda lambda) const
+    {
+        if constexpr (hasSummary)
+        {
+            summary.ForEachSet([this, &lambda](size_t index)
+            {
+                BitsetWord::ForEachSet(bitArray[index], index * wordSize, capacity, lambda);
+            });
+        }
+        else
+        {
+            for (size_t index = 0; index < bitArraySize; index++)
+            {
+                BitsetWord::ForEachSet(bitArray[index], index * wordSize, capacity, lambda);
+            }
+        }
+    }
+
+    /**
+     * @brief Get the number of set bits.
+     */
+    size_t Count() const
+    {
+        size_t count = 0;
+        for (size_t index = 0; index < bitArraySize; index++)
+        {
+            count += BitsetWord::PopCount(bitArray[index]);
+        }
+        return count;
+    }
 };
 
+/**
+ * @brief Bitset of runtime capacity with summary levels, a bit per non-empty word of the level below.
+ *
+ * All levels live in a single allocation, the bits first and each summary level after the one
+ * it summarizes, so lookups walk one block and resizing reallocates it once.
+ */
 class HierarchicalBitset
 {
 private:
     static constexpr size_t wordSize = CHAR_BIT * sizeof(size_t);
+    static constexpr size_t MaxLevels = wordSize / 4;
+
     size_t capacity = 0;
-    HierarchicalBitset *summary = nullptr;
-    size_t *bitArray = nullptr;
+    size_t levelCount = 0;                  /**< Levels in use, the bits and their summaries. */
+    size_t levelBits[MaxLevels] = {};       /**< Bits in each level, the words in the level below. */
+    size_t levelOffsets[MaxLevels] = {};    /**< First word of each level in the block. */
+    size_t *levels[MaxLevels] = {};         /**< Each level in the block, pointers cannot alias the words written through them. */
+    size_t *bitArray = nullptr;             /**< The block, starting with the bits themselves. */
 
     static size_t CalculateIndex(size_t pos) { return pos / wordSize; }
     static size_t CalculateBitMask(size_t pos)
@@ -135,58 +536,123 @@ private:
         return static_cast<size_t>(1) << (pos % wordSize);
     }
 
-    void SummaryResize(size_t indexCount)
+    static size_t CalculateArraySize(size_t capacity)
+    {
+        return (capacity + wordSize - 1) / wordSize;
+    }
+
+
+    /* Lay out the levels of a capacity, summary levels are added until one fits in a word */
+    void Layout(size_t newCapacity, size_t &totalWords)
     {
-        if (indexCount > 1)
+        levelCount = 0;
+        totalWords = 0;
+
+        size_t bits = newCapacity;
+        while (bits)
         {
-            if (!summary)
-            {
-                summary = new HierarchicalBitset(indexCount);
+            levelBits[levelCount] = bits;
+            levelOffsets[levelCount] = totalWords;
+            levelCount++;
 
-                if (summary)
-                {
-                    for (size_t i = 0; i < indexCount; i++)
-                    {
-                        if (bitArray[i] != 0)
-                        {
-                            summary->Set(i);
-                        }
-                    }
-                }
-            }
-            else
-            {
-                summary->Resize(indexCount);
-            }
+            const size_t words = CalculateArraySize(bits);
+            totalWords += words;
+            bits = (words > 1) ? words : 0;
         }
-        else
+    }
+
+    /* Recompute the summary levels from a level up, for the words [first, last) of that level */
+    void Summarize(size_t level, size_t first, size_t last)
+    {
+        for (; level + 1 < levelCount && first < last; level++)
         {
-            delete summary;
-            summary = nullptr;
+            const size_t *words = levels[level];
+            size_t *summary = levels[level + 1];
+            const size_t wordCount = levelBits[level + 1];
+
+            first = CalculateIndex(first);
+            last = CalculateIndex(last - 1) + 1;
+            for (size_t index = first; index < last; index++)
+            {
+                const size_t base = index * wordSize;
+                summary[index] = BitsetWord::Summarize(words + base, (wordCount - base < wordSize) ? wordCount - base : wordSize);
+            }
         }
     }
 
-    void SummarySet(size_t index)
+    /* Set the bits [first, last) of a level and of the summaries above it */
+    void LevelSetRange(size_t level, size_t first, size_t last)
     {
-        if (summary)
+        for (; level < levelCount && first < last; level++)
         {
-            summary->Set(index);
+            size_t *words = levels[level];
+            const size_t firstIndex = CalculateIndex(first);
+            const size_t lastIndex = CalculateIndex(last - 1);
+            const size_t firstMask = BitsetWord::MaskFrom(first % wordSize);
+            const size_t lastMask = BitsetWord::MaskTo((last - 1) % wordSize);
+
+            if (firstIndex == lastIndex)
+            {
+                words[firstIndex] |= firstMask & lastMask;
+            }
+            else
+            {
+                words[firstIndex] |= firstMask;
+                for (size_t index = firstIndex + 1; index < lastIndex; index++)
+                {
+                    words[index] = ~static_cast<size_t>(0);
+                }
+                words[lastIndex] |= lastMask;
+            }
+
+            first = firstIndex;
+            last = lastIndex + 1;
         }
     }
 
-    void SummaryClear(size_t index)
+    /* Clear the bits [first, last) of a level and the summary bits of the words it empties */
+    void LevelClearRange(size_t level, size_t first, size_t last)
     {
-        if (summary && (bitArray[index] == 0))
+        for (; level < levelCount && first < last; level++)
         {
-            summary->Clear(index);
+            size_t *words = levels[level];
+            const size_t firstIndex = CalculateIndex(first);
+            const size_t lastIndex = CalculateIndex(last - 1);
+            const size_t firstMask = BitsetWord::MaskFrom(first % wordSize);
+            const size_t lastMask = BitsetWord::MaskTo((last - 1) % wordSize);
+
+            if (firstIndex == lastIndex)
+            {
+                words[firstIndex] &= ~(firstMask & lastMask);
+            }
+            else
+            {
+                words[firstIndex] &= ~firstMask;
+                for (size_t index = firstIndex + 1; index < lastIndex; index++)
+                {
+                    words[index] = 0;
+                }
+                words[lastIndex] &= ~lastMask;
+            }
+
+            /* The emptied words are contiguous, inner ones and the edges left without bits */
+            first = firstIndex + (words[firstIndex] != 0);
+            last = lastIndex + (words[lastIndex] == 0);
         }
     }
 
-    bool SummaryGet(size_t pos) const { return !summary || summary->Get(pos); }
-
-    static size_t CalculateArraySize(size_t capacity)
+    /* Combine the bits with another bitset of the same capacity, then refresh the summaries */
+    template <typename Op>
+    bool Combine(const HierarchicalBitset &other, Op op)
     {
-        return (capacity + wordSize - 1) / wordSize;
+        /* Bitsets of different capacities are not combined, the caller resizes them first */
+        if (other.capacity != capacity)
+            return false;
+
+        const size_t bitArraySize = CalculateArraySize(capacity);
+        BitsetWord::Combine(bitArray, other.bitArray, bitArraySize, op);
+        Summarize(0, 0, bitArraySize);
+        return true;
     }
 
 public:
@@ -197,27 +663,50 @@ public:
         const size_t oldBitArraySize = CalculateArraySize(capacity);
         const size_t newBitArraySize = CalculateArraySize(newCapacity);
 
-        if (newBitArraySize != oldBitArraySize)
+        /* Clear the bits cut off in the last kept word, so growing back never exposes them */
+        const size_t tail = newCapacity % wordSize;
+        if (tail && newCapacity < capacity)
         {
-            size_t *newBitArray = static_cast<size_t *>(
-                realloc(bitArray, newBitArraySize * sizeof(size_t)));
-            if (!newBitArray)
-            {
-                return false;
-            }
-            else
-            {
-                bitArray = newBitArray;
+            bitArray[CalculateIndex(newCapacity)] &= (static_cast<size_t>(1) << tail) - 1;
+        }
 
-                for (size_t i = oldBitArraySize; i < newBitArraySize; i++)
-                {
-                    bitArray[i] = 0;
-                }
+        size_t oldLevelBits[MaxLevels];
+        size_t oldLevelOffsets[MaxLevels];
+        const size_t oldLevelCount = levelCount;
+        for (size_t level = 0; level < oldLevelCount; level++)
+        {
+            oldLevelBits[level] = levelBits[level];
+            oldLevelOffsets[level] = levelOffsets[level];
+        }
 
-                SummaryResize(newBitArraySize);
+        size_t totalWords;
+        Layout(newCapacity, totalWords);
+
+        size_t *newBitArray = static_cast<size_t *>(realloc(bitArray, (totalWords ? totalWords : 1) * sizeof(size_t)));
+        if (!newBitArray)
+        {
+            levelCount = oldLevelCount;
+            for (size_t level = 0; level < oldLevelCount; level++)
+            {
+                levelBits[level] = oldLevelBits[level];
+                levelOffsets[level] = oldLevelOffsets[level];
             }
+            return false;
+        }
+        bitArray = newBitArray;
+        for (size_t level = 0; level < levelCount; level++)
+        {
+            levels[level] = bitArray + levelOffsets[level];
         }
+
+        /* The bits stay in place at the front of the block, summaries are rebuilt behind them */
+        for (size_t i = oldBitArraySize; i < newBitArraySize; i++)
+        {
+            bitArray[i] = 0;
+        }
+
         capacity = newCapacity;
+        Summarize(0, 0, newBitArraySize);
         return true;
     }
 
@@ -227,7 +716,6 @@ public:
 
     ~HierarchicalBitset()
     {
-        delete summary;
         free(bitArray);
     }
 
@@ -237,11 +725,17 @@ public:
     {
         if (IsValid(pos))
         {
-            const size_t index = CalculateIndex(pos);
-            const size_t bitMask = CalculateBitMask(pos);
+            /* Climb while the cleared word becomes empty */
+            const size_t count = levelCount;
+            for (size_t level = 0; level < count; level++)
+            {
+                size_t &word = levels[level][CalculateIndex(pos)];
+                word &= ~CalculateBitMask(pos);
+                if (word != 0)
+                    return;
 
-            bitArray[index] &= ~bitMask;
-            SummaryClear(index);
+                pos = CalculateIndex(pos);
+            }
         }
     }
 
@@ -249,55 +743,204 @@ public:
     {
         if (IsValid(pos))
         {
-            const size_t index = CalculateIndex(pos);
-            const size_t bitMask = CalculateBitMask(pos);
-
-            bitArray[index] |= bitMask;
-            SummarySet(index);
+            /* Setting the summary bits unconditionally is cheaper than testing them */
+            const size_t count = levelCount;
+            for (size_t level = 0; level < count; level++)
+            {
+                levels[level][CalculateIndex(pos)] |= CalculateBitMask(pos);
+                pos = CalculateIndex(pos);
+            }
         }
     }
 
     bool Get(size_t pos) const
     {
-        return IsValid(pos) && SummaryGet(pos) &&
+        return IsValid(pos) &&
                (bitArray[CalculateIndex(pos)] & CalculateBitMask(pos));
     }
 
-    bool LookupSetPos(size_t &pos) const
+    /**
+     * @brief Set the bits from first up to last excluded, clamped to the capacity.
+     */
+    void SetRange(size_t first, size_t last)
     {
-        size_t searchIndex = 0;
-        if (summary && !summary->LookupSetPos(searchIndex))
-        {
+        LevelSetRange(0, first, (last > capacity) ? capacity : last);
+    }
+
+    /**
+     * @brief Clear the bits from first up to last excluded, clamped to the capacity.
+     */
+    void ClearRange(size_t first, size_t last)
+    {
+        LevelClearRange(0, first, (last > capacity) ? capacity : last);
+    }
+
+    /**
+     * @brief Keep only the bits also set in another bitset.
+     * @return true if both bitsets have the same capacity and were combined.
+     */
+    bool And(const HierarchicalBitset &other)
+    {
+        return Combine(other, [](auto a, auto b) { return a & b; });
+    }
+
+    /**
+     * @brief Set the bits set in another bitset.
+     * @return true if both bitsets have the same capacity and were combined.
+     */
+    bool Or(const HierarchicalBitset &other)
+    {
+        /* Bitsets of different capacities are not combined, the caller resizes them first */
+        if (other.capacity != capacity)
             return false;
+
+        /* Both blocks share a layout and a word is non-empty if it was in either bitset, so OR them whole */
+        const size_t totalWords = levelCount ? levelOffsets[levelCount - 1] + CalculateArraySize(levelBits[levelCount - 1]) : 0;
+        BitsetWord::Combine(bitArray, other.bitArray, totalWords, [](auto a, auto b) { return a | b; });
+        return true;
+    }
+
+    /**
+     * @brief Clear the bits set in another bitset.
+     * @return true if both bitsets have the same capacity and were combined.
+     */
+    bool AndNot(const HierarchicalBitset &other)
+    {
+        return Combine(other, [](auto a, auto b) { return a & ~b; });
+    }
+
+    /**
+     * @brief Flip the bits set in another bitset.
+     * @return true if both bitsets have the same capacity and were combined.
+     */
+    bool Xor(const HierarchicalBitset &other)
+    {
+        return Combine(other, [](auto a, auto b) { return a ^ b; });
+    }
+
+    /**
+     * @brief Check whether a bit is set in both bitsets.
+     * @return false as well if the capacities differ.
+     */
+    bool Intersects(const HierarchicalBitset &other) const
+    {
+        return other.capacity == capacity &&
+               BitsetWord::Intersects(bitArray, other.bitArray, CalculateArraySize(capacity));
+    }
+
+    /**
+     * @brief Find the first set bit at or after a position.
+     * @param pos The position to search from, set to the found bit.
+     * @return true if a set bit was found.
+     */
+    bool FindNext(size_t &pos) const
+    {
+        if (!IsValid(pos))
+            return false;
+
+        size_t search = pos;
+        size_t word = bitArray[CalculateIndex(search)] & BitsetWord::MaskFrom(search % wordSize);
+        size_t level = 0;
+
+        /* Climb until a level has a set bit at or after the position */
+        while (!word)
+        {
+            search = CalculateIndex(search) + 1;
+            if (++level == levelCount || search >= levelBits[level])
+                return false;
+
+            word = levels[level][CalculateIndex(search)] & BitsetWord::MaskFrom(search % wordSize);
         }
 
-        const size_t bitArraySize = CalculateArraySize(capacity);
+        /* Descend through the first non-empty word of each level below */
+        size_t found = (CalculateIndex(search) * wordSize) + BitsetWord::CountTrailingZeros(word);
+        while (level-- > 0)
+        {
+            found = (found * wordSize) + BitsetWord::CountTrailingZeros(levels[level][found]);
+        }
 
-        size_t i;
-        size_t searchWord;
+        if (!IsValid(found))
+            return false;
 
-        while (searchIndex < bitArraySize)
+        pos = found;
+        return true;
+    }
+
+    /**
+     * @brief Find the last clear bit before a position, a word at a time.
+     * @param pos The position to search before, set to the found bit.
+     * @return false if every bit before the position is set.
+     */
+    bool FindPreviousClear(size_t &pos) const
+    {
+        if (pos > capacity)
+            pos = capacity;
+
+        for (size_t end = pos; end;)
         {
-            i = 0;
-            searchWord = bitArray[searchIndex];
+            const size_t index = CalculateIndex(end - 1);
+            const size_t word = ~bitArray[index] & BitsetWord::MaskTo((end - 1) % wordSize);
+            if (word)
+            {
+                pos = (index * wordSize) + (wordSize - 1) - BitsetWord::CountLeadingZeros(word);
+                return true;
+            }
+            end = index * wordSize;
+        }
+        return false;
+    }
 
-            while (searchWord && i < wordSize)
+    bool LookupSetPos(size_t &pos) const
+    {
+        size_t found = 0;
+        if (!FindNext(found))
+            return false;
+
+        pos = found;
+        return true;
+    }
+
+    /**
+     * @brief Call a lambda with the position of every set bit, in increasing order.
+     * Empty words are skipped through the summary. The lambda may clear the bits it visits.
+     * @param lambda Function taking the position of a set bit.
+     */
+    template <typename Lambda>
+    void ForEachSet(Lambda lambda) const
+    {
+        if (levelCount < 2)
+        {
+            if (capacity)
             {
-                if (searchWord & 1)
-                {
-                    size_t new_pos = (searchIndex * wordSize) + i;
-                    if (new_pos < capacity)
-                    {
-                        pos = new_pos;
-                        return true;
-                    }
-                }
-                searchWord >>= 1;
-                ++i;
+                BitsetWord::ForEachSet(bitArray[0], 0, capacity, lambda);
             }
-            searchIndex++;
+            return;
         }
 
-        return false;
+        /* Walk the words of the first summary level, each set bit there is a non-empty word here */
+        const size_t bitArraySize = levelBits[1];
+        const size_t *summary = levels[1];
+        auto visitWord = [this, &lambda](size_t index)
+        {
+            BitsetWord::ForEachSet(bitArray[index], index * wordSize, capacity, lambda);
+        };
+        for (size_t summaryIndex = 0; summaryIndex < CalculateArraySize(bitArraySize); summaryIndex++)
+        {
+            BitsetWord::ForEachSet(summary[summaryIndex], summaryIndex * wordSize, bitArraySize, visitWord);
+        }
+    }
+
+    /**
+     * @brief Get the number of set bits.
+     */
+    size_t Count() const
+    {
+        size_t count = 0;
+        const size_t bitArraySize = CalculateArraySize(capacity);
+        for (size_t index = 0; index < bitArraySize; index++)
+        {
+            count += BitsetWord::PopCount(bitArray[index]);
+        }
+        return count;
     }
 };
@@ -2,112 +2,202 @@
 
 #include "HierarchicalBitset.hpp"
 
-template <size_t IdCapacity>
-class FixedIdTracker
+/**
+ * @brief Order in which freed IDs are handed out again.
+ */
+enum class IdReuse
 {
-    size_t last = 0;
-    FixedHierarchicalBitset<IdCapacity> recycleBin;
+    Lowest,     /**< Lowest free ID first, keeps arrays indexed by ID dense. */
+    MostRecent  /**< Most recently freed ID first, its data is likely still in cache. */
+};
 
-    bool InUsedRange(size_t id) const { return id < last; }
+/**
+ * @brief Ring of the last freed IDs, only kept by trackers reusing the most recent ones.
+ */
+template <IdReuse Reuse>
+struct RecentIds
+{
+    static constexpr size_t capacity = 32;
 
-public:
-    static constexpr size_t capacity = IdCapacity;
+    size_t ids[capacity];
+    size_t top = 0;
+    size_t size = 0;
 
-    bool IsUsed(size_t id) { return InUsedRange(id) && !recycleBin.Get(id); }
+    void Push(size_t id)
+    {
+        ids[top] = id;
+        top = (top + 1) % capacity;
+        if (size < capacity)
+            size++;
+    }
+
+    bool Pop(size_t &id)
+    {
+        if (size == 0)
+            return false;
+
+        top = (top + capacity - 1) % capacity;
+        size--;
+        id = ids[top];
+        return true;
+    }
+};
+
+template <>
+struct RecentIds<IdReuse::Lowest>
+{
+    void Push(size_t) {}
+    bool Pop(size_t &) { return false; }
+};
+
+/**
+ * @brief Used range, recycle bin and batch operations shared by the ID trackers.
+ * @tparam Bitset The recycle bin type, a bit per freed ID below the end of the used range.
+ * @tparam Reuse Order in which freed IDs are handed out again.
+ */
+template <typename Bitset, IdReuse Reuse>
+class IdTrackerBase
+{
+protected:
+    size_t last = 0;
+    size_t freed = 0;
+    Bitset recycleBin;
+    RecentIds<Reuse> recent;
+
+    bool InUsedRange(size_t id) const { return id < last; }
 
-    void FreeId(size_t id)
+    /**
+     * @brief Assign a batch of IDs, reused ones in the order of the reuse policy, then new ones.
+     * @param count The number of IDs wanted.
+     * @param ids Receives the assigned IDs.
+     * @param capacity The number of IDs the tracker holds.
+     * @return The number of IDs assigned, lower than count if the tracker is full.
+     */
+    size_t Assign(size_t count, size_t *ids, size_t capacity)
     {
-        if (InUsedRange(id))
+        size_t assigned = 0;
+
+        size_t id;
+        while (assigned < count && recent.Pop(id))
         {
-            if (id == last - 1)
+            /* Recent entries may have been reused since, or cut off by a lowered used range */
+            if (InUsedRange(id) && recycleBin.Get(id))
             {
-                last--;
                 recycleBin.Clear(id);
+                freed--;
+                ids[assigned++] = id;
             }
-            else
+            else if (id == last && last < capacity)
             {
-                recycleBin.Set(id);
+                ids[assigned++] = last++;
             }
         }
-    }
 
-    bool AssingId(size_t &id)
-    {
-        if (last < capacity)
+        if (freed && assigned < count)
         {
-            id = last++;
-            return true;
+            /* Every free ID below the last one taken is taken, so clear them as a range */
+            size_t pos = 0;
+            while (assigned < count && recycleBin.FindNext(pos))
+            {
+                ids[assigned++] = pos++;
+                freed--;
+            }
+            recycleBin.ClearRange(0, pos);
         }
 
-        if (recycleBin.LookupSetPos(id))
+        const size_t fresh = (count - assigned < capacity - last) ? count - assigned : capacity - last;
+        for (size_t i = 0; i < fresh; i++)
         {
-            recycleBin.Clear(id);
-            return true;
+            ids[assigned++] = last + i;
         }
+        last += fresh;
 
-        return false;
+        return assigned;
     }
+
+public:
+    bool IsUsed(size_t id) { return InUsedRange(id) && !recycleBin.Get(id); }
+
+    /**
+     * @brief Free a batch of IDs, then lower the end of the used range past the trailing free IDs at once.
+     * IDs not in use are ignored.
+     * @param ids The IDs to free.
+     * @param count The number of IDs.
+     */
+    void FreeIds(const size_t *ids, size_t count)
+    {
+        for (size_t i = 0; i < count; i++)
+        {
+            if (IsUsed(ids[i]))
+            {
+                recycleBin.Set(ids[i]);
+                recent.Push(ids[i]);
+                freed++;
+            }
+        }
+
+        /* The used range ends after the last ID still in use, found a word at a time */
+        size_t newLast = last;
+        newLast = recycleBin.FindPreviousClear(newLast) ? newLast + 1 : 0;
+        recycleBin.ClearRange(newLast, last);
+        freed -= last - newLast;
+        last = newLast;
+    }
+
+    void FreeId(size_t id) { FreeIds(&id, 1); }
 };
 
-class IdTracker
+template <size_t IdCapacity, IdReuse Reuse = IdReuse::Lowest>
+class FixedIdTracker : public IdTrackerBase<FixedHierarchicalBitset<IdCapacity>, Reuse>
 {
-    size_t capacity = 0;
-    size_t last = 0;
-    HierarchicalBitset recycleBin;
+public:
+    static constexpr size_t capacity = IdCapacity;
 
-    bool InUsedRange(size_t id) const { return id < last; }
+    /**
+     * @brief Assign a batch of IDs, reused ones in the order of the reuse policy, then new ones.
+     * @param count The number of IDs wanted.
+     * @param ids Receives the assigned IDs.
+     * @return The number of IDs assigned, lower than count if the tracker is full.
+     */
+    size_t AssignIds(size_t count, size_t *ids) { return this->Assign(count, ids, capacity); }
+
+    bool AssingId(size_t &id) { return AssignIds(1, &id) == 1; }
+};
+
+template <IdReuse Reuse = IdReuse::Lowest>
+class BasicIdTracker : public IdTrackerBase<HierarchicalBitset, Reuse>
+{
+    size_t capacity = 0;
 
 public:
-    IdTracker() {}
+    BasicIdTracker() {}
 
     bool Resize(size_t newCapacity)
     {
-        if (recycleBin.Resize(newCapacity))
+        if (this->recycleBin.Resize(newCapacity))
         {
             capacity = newCapacity;
-            if (last > capacity)
-                last = capacity;
+            if (this->last > capacity)
+                this->last = capacity;
+            this->freed = this->recycleBin.Count();
             return true;
         }
         return false;
     }
 
-    IdTracker(size_t capacity) { Resize(capacity); }
+    BasicIdTracker(size_t capacity) { Resize(capacity); }
 
     size_t GetCapacity() { return capacity; }
 
-    bool IsUsed(size_t id) { return InUsedRange(id) && !recycleBin.Get(id); }
+    /**
+     * @brief Assign a batch of IDs, reused ones in the order of the reuse policy, then new ones.
+     * @param count The number of IDs wanted.
+     * @param ids Receives the assigned IDs.
+     * @return The number of IDs assigned, lower than count if the tracker is full.
+     */
+    size_t AssignIds(size_t count, size_t *ids) { return this->Assign(count, ids, capacity); }
 
-    void FreeId(size_t id)
-    {
-        if (InUsedRange(id))
-        {
-            if (id == last - 1)
-            {
-                last--;
-                recycleBin.Clear(id);
-            }
-            else
-            {
-                recycleBin.Set(id);
-            }
-        }
-    }
-
-    bool AssingId(size_t &id)
-    {
-        if (last < capacity)
-        {
-            id = last++;
-            return true;
-        }
-
-        if (recycleBin.LookupSetPos(id))
-        {
-            recycleBin.Clear(id);
-            return true;
-        }
-
-        return false;
-    }
+    bool AssingId(size_t &id) { return AssignIds(1, &id) == 1; }
 };
+
+using IdTracker = BasicIdTracker<>;
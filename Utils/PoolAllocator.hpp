@@ -0,0 +1,205 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "SatAlloc.hpp"
+#include "std/utils.h"
+
+#ifndef HYPERION_POOL_SLAB_BLOCKS
+/**
+ * @brief Number of blocks a pool takes from its memory region at once.
+ */
+#define HYPERION_POOL_SLAB_BLOCKS 64
+#endif
+
+/**
+ * @brief Pool of fixed-size blocks carved from slabs of a memory region.
+ *
+ * Free blocks are linked through their own first bytes, so allocating and freeing a block is a
+ * list pop or push, with no per-block header and no splitting or merging. Blocks freed go back to
+ * the pool, slabs are only returned to the region by Release once every block is freed.
+ * @tparam BlockSize Size of the blocks, rounded up to keep every block aligned for any type.
+ * @tparam Region The memory region slabs are allocated from.
+ */
+template <size_t BlockSize, MemoryRegion Region = MemoryRegion::LWRAM>
+class BlockPool
+{
+private:
+    static constexpr size_t alignment = alignof(max_align_t);
+    static constexpr size_t blockSize = ((BlockSize < sizeof(void *) ? sizeof(void *) : BlockSize) + alignment - 1) & ~(alignment - 1);
+    static constexpr size_t slabBlocks = HYPERION_POOL_SLAB_BLOCKS;
+
+    struct FreeBlock
+    {
+        FreeBlock *next;
+    };
+
+    /* Header at the start of each slab, padded so the blocks after it stay aligned */
+    struct alignas(max_align_t) Slab
+    {
+        Slab *next;
+    };
+
+    Slab *slabs = nullptr;
+    FreeBlock *freeBlocks = nullptr;
+    size_t live = 0;
+    size_t slabCount = 0;
+
+    bool Grow()
+    {
+        Slab *slab = (Slab *)region_malloc<Region>(sizeof(Slab) + (slabBlocks * blockSize));
+        if (!slab)
+            return false;
+
+        slab->next = slabs;
+        slabs = slab;
+        slabCount++;
+
+        /* Link the blocks so the lowest address is handed out first */
+        char *blocks = (char *)(slab + 1);
+        for (size_t index = slabBlocks; index-- > 0;)
+        {
+            FreeBlock *block = (FreeBlock *)(blocks + (index * blockSize));
+            block->next = freeBlocks;
+            freeBlocks = block;
+        }
+        return true;
+    }
+
+public:
+    static constexpr size_t size = blockSize;
+
+    constexpr BlockPool() {}
+
+    ~BlockPool() { Release(); }
+
+    BlockPool(const BlockPool &) = delete;
+    BlockPool &operator=(const BlockPool &) = delete;
+
+    /**
+     * @brief Take a block, the pool grows by a slab when empty.
+     * @return The block, or nullptr if the region ran out of memory.
+     */
+    void *Allocate()
+    {
+        if (!freeBlocks && !Grow())
+            return nullptr;
+
+        FreeBlock *block = freeBlocks;
+        freeBlocks = block->next;
+        live++;
+        return block;
+    }
+
+    /**
+     * @brief Give a block taken from this pool back.
+     */
+    void Free(void *ptr)
+    {
+        if (!ptr)
+            return;
+
+        FreeBlock *block = (FreeBlock *)ptr;
+        block->next = freeBlocks;
+        freeBlocks = block;
+        live--;
+    }
+
+    /**
+     * @brief Return every slab to the region.
+     * @return false if blocks are still in use, the slabs are kept.
+     */
+    bool Release()
+    {
+        if (live)
+            return false;
+
+        while (slabs)
+        {
+            Slab *next = slabs->next;
+            region_free<Region>(slabs);
+            slabs = next;
+        }
+        freeBlocks = nullptr;
+        slabCount = 0;
+        return true;
+    }
+
+    /**
+     * @brief Number of blocks in use.
+     */
+    size_t Live() const { return live; }
+
+    /**
+     * @brief Bytes taken from the region, slab headers included.
+     */
+    size_t Reserved() const { return slabCount * (sizeof(Slab) + (slabBlocks * blockSize)); }
+};
+
+/**
+ * @brief Allocation policy of containers using the global heap, through new and delete.
+ */
+struct HeapAllocator
+{
+    template <typename T, typename... Args>
+    static T *New(Args &&...args) { return new T(std::forward<Args>(args)...); }
+
+    template <typename T>
+    static void Delete(T *object) { delete object; }
+
+    static void *Allocate(size_t size) { return new char[size]; }
+
+    static void Free(void *ptr, size_t) { delete[] (char *)ptr; }
+};
+
+/**
+ * @brief Allocation policy of containers using block pools, shared by every object of the same size.
+ * @tparam Region The memory region the pools take their slabs from.
+ * @tparam SmallSize Buffers up to this size come from a pool, larger ones from the region heap.
+ */
+template <MemoryRegion Region = MemoryRegion::LWRAM, size_t SmallSize = 32>
+struct PoolAllocator
+{
+    template <size_t Size>
+    static inline BlockPool<Size, Region> pool;
+
+    /**
+     * @brief Construct an object in a pool block.
+     * @return The object, or nullptr if the region ran out of memory.
+     */
+    template <typename T, typename... Args>
+    static T *New(Args &&...args)
+    {
+        static_assert(alignof(T) <= alignof(max_align_t), "Pool blocks are not aligned enough for this type");
+
+        void *block = pool<sizeof(T)>.Allocate();
+        return block ? new (block) T(std::forward<Args>(args)...) : nullptr;
+    }
+
+    template <typename T>
+    static void Delete(T *object)
+    {
+        if (!object)
+            return;
+
+        object->~T();
+        pool<sizeof(T)>.Free(object);
+    }
+
+    /**
+     * @brief Allocate a buffer, the size must be passed again to Free.
+     */
+    static void *Allocate(size_t size)
+    {
+        return (size <= SmallSize) ? pool<SmallSize>.Allocate() : region_malloc<Region>(size);
+    }
+
+    static void Free(void *ptr, size_t size)
+    {
+        if (size <= SmallSize)
+            pool<SmallSize>.Free(ptr);
+        else
+            region_free<Region>(ptr);
+    }
+};
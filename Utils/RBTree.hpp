@@ -3,20 +3,34 @@
 #include <stdlib.h>
 #include <stdint.h>
 
-template <typename K, typename V>
+#include "PoolAllocator.hpp"
+
+/**
+ * @brief Red-black tree.
+ * @tparam K Key type.
+ * @tparam V Value type.
+ * @tparam Allocator Allocation policy of the nodes, HeapAllocator or a PoolAllocator.
+ */
+template <typename K, typename V, typename Allocator = HeapAllocator>
 class RBTree
 {
 public:
+    /**
+     * @return The inserted value, or nullptr if memory ran out.
+     */
     V *Insert(const K &key, const V &data)
     {
         if (root == nullptr)
         {
-            root = new RBNode(key, data, Color::Black);
-            return &root->data;
+            root = Allocator::template New<RBNode>(key, data, Color::Black);
+            return root ? &root->data : nullptr;
         }
         else
         {
-            RBNode *newNode = new RBNode(key, data, Color::Red);
+            RBNode *newNode = Allocator::template New<RBNode>(key, data, Color::Red);
+            if (!newNode)
+                return nullptr;
+
             AssignParent(root, newNode);
             InsertFixup(&root, newNode);
             return &newNode->data;
@@ -29,6 +43,15 @@ public:
         return (search) ? &search->data : nullptr;
     }
 
+    /**
+     * @brief Remove every node.
+     */
+    void Clear()
+    {
+        DeleteSubTree(root);
+        root = nullptr;
+    }
+
 private:
     enum class Color
     {
@@ -87,8 +110,8 @@ private:
 
         node->left = leftNode->right;
 
-        if (node->right != nullptr)
-            node->right->parent = node;
+        if (node->left != nullptr)
+            node->left->parent = node;
 
         leftNode->parent = node->parent;
 
@@ -306,6 +329,17 @@ private:
         replacement->parent = target->parent;
     }
 
+    void DeleteSubTree(RBNode *node)
+    {
+        while (node != nullptr)
+        {
+            DeleteSubTree(node->left);
+            RBNode *right = node->right;
+            Allocator::Delete(node);
+            node = right;
+        }
+    }
+
     RBNode *TreeMinimum(RBNode *subTreeRoot)
     {
         while (subTreeRoot->left != nullptr)
@@ -366,7 +400,7 @@ private:
             minimumNode->left->parent = minimumNode;
             minimumNode->color = node->color;
         }
-        delete node;
+        Allocator::Delete(node);
 
         if (originalColor == Color::Black)
             DeleteFixup(root, temp);
@@ -93,6 +93,38 @@ namespace cart_ram
     }
 }
 
+/**
+ * @brief Memory region an allocator carves its blocks from.
+ */
+enum class MemoryRegion
+{
+    HWRAM,  /**< Work RAM high, the system heap. */
+    LWRAM,  /**< Work RAM low, see lwram. */
+    Cart    /**< DRAM cartridge, see cart_ram, allocations fail without one. */
+};
+
+template <MemoryRegion Region>
+inline void* region_malloc(size_t size)
+{
+    if constexpr (Region == MemoryRegion::LWRAM)
+        return lwram::malloc(size);
+    else if constexpr (Region == MemoryRegion::Cart)
+        return cart_ram::malloc(size);
+    else
+        return malloc(size);
+}
+
+template <MemoryRegion Region>
+inline void region_free(void* ptr)
+{
+    if constexpr (Region == MemoryRegion::LWRAM)
+        lwram::free(ptr);
+    else if constexpr (Region == MemoryRegion::Cart)
+        cart_ram::free(ptr);
+    else
+        free(ptr);
+}
+
 inline void auto_detect_free(void* ptr)
 {
     if (lwram::internal::in_range(ptr))
@@ -4,6 +4,30 @@
 #include <assert.h>
 #include "CPUTools.hpp"
 
+#ifdef HYPERION_HOST
+#include <time.h>
+
+/**
+ * @brief Host stand-in for the FRT driven clock, milliseconds of the monotonic clock since Initialize.
+ */
+class SystemTime
+{
+private:
+    static inline uint64_t start = 0;
+
+    static uint64_t Now()
+    {
+        timespec now;
+        clock_gettime(CLOCK_MONOTONIC, &now);
+        return static_cast<uint64_t>(now.tv_sec) * 1000 + static_cast<uint64_t>(now.tv_nsec) / 1000000;
+    }
+
+public:
+    static void Initialize() { start = Now(); }
+
+    static uint32_t CurrentTime() { return static_cast<uint32_t>(Now() - start); }
+};
+#else
 class SystemTime
 {
 private:
@@ -49,6 +73,7 @@ public:
         return NoCache(ms);
     }
 };
+#endif
 
 class Timer
 {
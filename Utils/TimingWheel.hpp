@@ -0,0 +1,290 @@
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+#include "SatAlloc.hpp"
+#include "HierarchicalBitset.hpp"
+
+#ifndef HYPERION_TIMED_EVENT_PAYLOAD
+/**
+ * @brief Largest event in bytes a TimingWheel holds, must be a multiple of 4.
+ */
+#define HYPERION_TIMED_EVENT_PAYLOAD 28
+#endif
+
+/**
+ * @brief Hierarchical timing wheel of events due at a given millisecond.
+ *
+ * Level 0 has a slot per millisecond of the current window of wordSize milliseconds, each level
+ * above has a slot per window of the level below. An event goes in the lowest level whose span
+ * covers its delay, and moves down a level each time the wheel reaches its slot, so it is touched
+ * once per level instead of once per frame. Each level keeps a word with a bit per non-empty slot,
+ * the wheel skips to the next due slot instead of stepping every millisecond.
+ * Events further away than the top level span wait in its last slot and are placed again from there.
+ */
+class TimingWheel
+{
+public:
+    static constexpr size_t payloadSize = HYPERION_TIMED_EVENT_PAYLOAD;
+
+    static_assert(payloadSize % sizeof(uint32_t) == 0, "HYPERION_TIMED_EVENT_PAYLOAD must be a multiple of 4");
+
+private:
+    static constexpr size_t slotCount = BitsetWord::wordSize;
+    static constexpr size_t slotBits = (slotCount == 64) ? 6 : 5;
+    static constexpr uint32_t slotMask = slotCount - 1;
+    static constexpr size_t levels = 5;
+    static constexpr uint32_t span = static_cast<uint32_t>(1) << (slotBits * levels);
+    static constexpr uint32_t none = ~static_cast<uint32_t>(0);
+
+    static_assert(slotBits * levels < 32, "Timing wheel span must fit in the time type");
+
+    struct Node
+    {
+        uint32_t next;
+        uint32_t due;
+        uint32_t eventTypeId;
+        uint32_t data[payloadSize / sizeof(uint32_t)];
+    };
+
+    struct Slot
+    {
+        uint32_t first = none;
+        uint32_t last = none;
+    };
+
+    Slot slots[levels][slotCount];
+    size_t occupied[levels] = {0};
+
+    Node *nodes = nullptr;
+    uint32_t nodeCapacity = 0;
+    uint32_t freeNode = none;
+    size_t pending = 0;
+
+    uint32_t wheelTime = 0;     /**< Next millisecond to process, every earlier event has been handed out or is overdue. */
+    Slot overdue;               /**< Events the handler refused, due before any event of the wheel. */
+
+    /**
+     * @brief Link a node at the end of the slot of its due time, relative to the wheel time.
+     */
+    void Place(uint32_t index)
+    {
+        const uint32_t due = nodes[index].due;
+        const uint32_t delay = due - wheelTime;
+
+        size_t level = 0;
+        uint32_t slotTime = due;
+        if (delay >= span)
+        {
+            /* Wait in the top level slot reached last, the event is placed again from there */
+            level = levels - 1;
+            slotTime = wheelTime + span - 1;
+        }
+        else
+        {
+            while (delay >> (slotBits * (level + 1)))
+            {
+                level++;
+            }
+        }
+
+        const size_t position = (slotTime >> (slotBits * level)) & slotMask;
+        Slot &slot = slots[level][position];
+        nodes[index].next = none;
+        if (slot.first == none)
+        {
+            slot.first = index;
+            occupied[level] |= static_cast<size_t>(1) << position;
+        }
+        else
+        {
+            nodes[slot.last].next = index;
+        }
+        slot.last = index;
+    }
+
+    /**
+     * @brief Unlink every node of a slot.
+     * @return The first node of the list, in the order they were added.
+     */
+    uint32_t Take(size_t level, size_t position)
+    {
+        Slot &slot = slots[level][position];
+        const uint32_t first = slot.first;
+        slot.first = none;
+        occupied[level] &= ~(static_cast<size_t>(1) << position);
+        return first;
+    }
+
+    /**
+     * @brief Hand out a list of events, the ones from the first refused on are kept as overdue.
+     * @return false if the handler refused an event.
+     */
+    template <typename Handler>
+    bool HandOut(Slot list, Handler &handler)
+    {
+        for (uint32_t index = list.first; index != none;)
+        {
+            /* The handler may grow the nodes, it gets a copy */
+            const Node node = nodes[index];
+            if (!handler(node.eventTypeId, (const void *)node.data))
+            {
+                overdue.first = index;
+                overdue.last = list.last;
+                return false;
+            }
+
+            nodes[index].next = freeNode;
+            freeNode = index;
+            pending--;
+            index = node.next;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Move the slots of the upper levels reached at the start of a level 0 window down the wheel.
+     */
+    void Cascade()
+    {
+        for (size_t level = 1; level < levels; level++)
+        {
+            const size_t position = (wheelTime >> (slotBits * level)) & slotMask;
+            for (uint32_t index = Take(level, position); index != none;)
+            {
+                const uint32_t next = nodes[index].next;
+                Place(index);
+                index = next;
+            }
+
+            if (position != 0)
+                break;
+        }
+    }
+
+    bool Grow()
+    {
+        const uint32_t newCapacity = (nodeCapacity == 0) ? 16 : (nodeCapacity * 2) - (nodeCapacity / 2);
+        Node *newNodes = (Node *)lwram::realloc(nodes, newCapacity * sizeof(Node));
+        if (!newNodes)
+            return false;
+
+        nodes = newNodes;
+        for (uint32_t index = newCapacity; index-- > nodeCapacity;)
+        {
+            nodes[index].next = freeNode;
+            freeNode = index;
+        }
+        nodeCapacity = newCapacity;
+        return true;
+    }
+
+public:
+    TimingWheel() {}
+
+    ~TimingWheel() { lwram::free(nodes); }
+
+    TimingWheel(const TimingWheel &) = delete;
+    TimingWheel &operator=(const TimingWheel &) = delete;
+
+    /**
+     * @brief Number of events waiting for their time.
+     */
+    size_t Pending() const { return pending; }
+
+    /**
+     * @brief Move an empty wheel ahead to the current time, so a wheel left idle does not step through
+     * the time it missed once events are added.
+     */
+    void Skip(uint32_t now)
+    {
+        if (pending == 0)
+            wheelTime = now;
+    }
+
+    /**
+     * @brief Add an event, nodes grow as needed.
+     * @param due The time the event is due. Events due before the wheel time, one past the time reached by the
+     * last Advance, are due at the wheel time: another Advance to that same time does not hand them out.
+     * @param eventTypeId Type of the event.
+     * @param data The event, may be nullptr if size is 0.
+     * @param size Size of the event, at most payloadSize.
+     * @return false if memory ran out.
+     */
+    bool Schedule(uint32_t due, uint32_t eventTypeId, const void *data, size_t size)
+    {
+        if (freeNode == none && !Grow())
+            return false;
+
+        /* Times wrap around, compare their distance */
+        if (static_cast<int32_t>(due - wheelTime) < 0)
+            due = wheelTime;
+
+        const uint32_t index = freeNode;
+        freeNode = nodes[index].next;
+        nodes[index].due = due;
+        nodes[index].eventTypeId = eventTypeId;
+        if (size)
+            memcpy(nodes[index].data, data, size);
+
+        Place(index);
+        pending++;
+        return true;
+    }
+
+    /**
+     * @brief Hand out every event due up to a time, in order of due time then of scheduling.
+     * The cost is the number of events handed out plus one step per level 0 window crossed.
+     * @param now The current time.
+     * @param handler Called as handler(eventTypeId, data) for each event, it may schedule events. It returns
+     * false to refuse an event: that event and the ones due with or after it stay in the wheel, the next
+     * Advance hands them out first.
+     * @return false if the handler refused an event.
+     */
+    template <typename Handler>
+    bool Advance(uint32_t now, Handler &&handler)
+    {
+        /* Events refused last time were due before any other */
+        const Slot refused = overdue;
+        overdue = Slot();
+        if (!HandOut(refused, handler))
+            return false;
+
+        while (static_cast<int32_t>(now - wheelTime) >= 0)
+        {
+            if (pending == 0)
+            {
+                wheelTime = now + 1;
+                break;
+            }
+
+            const uint32_t position = wheelTime & slotMask;
+            if (position == 0)
+                Cascade();
+
+            /* Next non-empty slot of the window, or the start of the next window */
+            const size_t due = occupied[0] & BitsetWord::MaskFrom(position);
+            const uint32_t next = due ? (wheelTime & ~slotMask) + BitsetWord::CountTrailingZeros(due)
+                                      : (wheelTime | slotMask) + 1;
+            if (next - wheelTime > now - wheelTime)
+            {
+                wheelTime = now + 1;
+                break;
+            }
+
+            wheelTime = next;
+            if (!due)
+                continue;
+
+            /* Events scheduled by the handler for this millisecond go to the next one */
+            wheelTime++;
+            const Slot taken = slots[0][next & slotMask];
+            Take(0, next & slotMask);
+            if (!HandOut(taken, handler))
+                return false;
+        }
+        return true;
+    }
+};
@@ -1,7 +1,7 @@
 #pragma once
 
-#include "..\Math\Fxp.hpp"
-#include "..\std\type_traits.h"
+#include "../Math/Fxp.hpp"
+#include "../std/type_traits.h"
 
 class Trigonometry
 {
@@ -1,100 +1,141 @@
 #pragma once
 
 #include "utils.h"
+#include "../PoolAllocator.hpp"
 #include <string.h>
 
 namespace std
 {
-    class string
+    /**
+     * @brief Null terminated string owning its characters.
+     * A string whose characters could not be allocated is left empty.
+     * @tparam Allocator Allocation policy of the characters, HeapAllocator or a PoolAllocator.
+     */
+    template <typename Allocator = HeapAllocator>
+    class basic_string
     {
     private:
         char* str = nullptr;
+        size_t capacity = 0;    /**< Bytes allocated for str, given back to the allocator as is. */
+
+        /**
+         * @brief Allocate the characters, leaving the string empty if allocation fails.
+         * @return true if allocated.
+         */
+        bool Allocate(size_t size)
+        {
+            str = (char*)Allocator::Allocate(size);
+            capacity = str ? size : 0;
+            return str != nullptr;
+        }
+
+        static size_t Length(const char* characters)
+        {
+            return characters ? strlen(characters) : 0;
+        }
+
+        void Release()
+        {
+            if (str)
+                Allocator::Free(str, capacity);
+        }
 
     public:
         // Default constructor
-        string() : str(nullptr) {}
+        basic_string() : str(nullptr), capacity(0) {}
 
         // Constructor with source string
-        string(const char* src)
+        basic_string(const char* src)
         {
-            str = new char[strlen(src) + 1];
-            strcpy(str, src);
+            if (Allocate(strlen(src) + 1))
+                strcpy(str, src);
         }
 
         template <typename... Args>
-        string(const char* format, Args... args)
+        basic_string(const char* format, Args... args)
         {
             size_t size = snprintf(nullptr, 0, format, args...) + 1;
-            str = new char[size];
-            snprintf(str, size, format, args...);
+            if (Allocate(size))
+                snprintf(str, size, format, args...);
         }
 
         template <typename T, typename = std::enable_if_t<std::is_integral_v<T>>>
-        string(const T& integer)
+        basic_string(const T& integer)
         {
             size_t size = snprintf(nullptr, 0, "%d", integer) + 1;
-            str = new char[size];
-            snprintf(str, size, "%d", integer);
+            if (Allocate(size))
+                snprintf(str, size, "%d", integer);
         }
 
         // Copy constructor
-        string(const string& other)
+        basic_string(const basic_string& other)
         {
-            str = new char[strlen(other.str) + 1];
-            strcpy(str, other.str);
+            if (other.str && Allocate(strlen(other.str) + 1))
+                strcpy(str, other.str);
         }
 
         // Copy assignment operator
-        string& operator=(const string& other)
+        basic_string& operator=(const basic_string& other)
         {
             if (this != &other)
             {
-                delete[] str;
-                str = new char[strlen(other.str) + 1];
-                strcpy(str, other.str);
+                Release();
+                str = nullptr;
+                capacity = 0;
+                if (other.str && Allocate(strlen(other.str) + 1))
+                    strcpy(str, other.str);
             }
             return *this;
         }
 
         // Move constructor
-        string(string&& other) noexcept
-            : str(other.str)
+        basic_string(basic_string&& other) noexcept
+            : str(other.str), capacity(other.capacity)
         {
             other.str = nullptr;
+            other.capacity = 0;
         }
 
         // Move assignment operator
-        string& operator=(string&& other) noexcept
+        basic_string& operator=(basic_string&& other) noexcept
         {
             if (this != &other)
             {
-                delete[] str;
+                Release();
                 str = other.str;
+                capacity = other.capacity;
                 other.str = nullptr;
+                other.capacity = 0;
             }
             return *this;
         }
 
         // Overloaded + operator for string concatenation
-        string operator+(const string& other) const
+        basic_string operator+(const basic_string& other) const
         {
-            string result;
-            result.str = new char[strlen(str) + strlen(other.str) + 1];
-            strcpy(result.str, str);
-            strcat(result.str, other.str);
+            basic_string result;
+            const size_t length = Length(str);
+            const size_t otherLength = Length(other.str);
+            if (result.Allocate(length + otherLength + 1))
+            {
+                memcpy(result.str, c_str(), length);
+                memcpy(result.str + length, other.c_str(), otherLength + 1);
+            }
             return result;
         }
 
         // Destructor
-        ~string()
+        ~basic_string()
         {
-            delete[] str;
+            Release();
         }
 
 
         const char* c_str() const
         {
-            return str;
+            return str ? str : "";
         }
     };
+
+    using string = basic_string<>;
 }
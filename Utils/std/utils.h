@@ -1,5 +1,7 @@
 #pragma once
 
+#include <stdint.h>
+
 #include "type_traits.h"
 
 namespace std
@@ -241,6 +243,34 @@ inline const char* TypeName()
     return typeName;
 }
 
+/**
+ * @brief 32-bit FNV-1a hash of the name of a type, computed at compile time.
+ * Unlike TypeInfo::ID, the value depends only on the spelling of the type, not on the order
+ * in which types are instantiated, so it can be persisted.
+ */
+template <typename T>
+constexpr auto TypeNameHash()
+{
+    // The type follows the first '=' of "[with T = ...]" and runs up to the closing bracket
+    constexpr size_t prettyFunctionSize = sizeof(__PRETTY_FUNCTION__);
+    constexpr const char* function = __PRETTY_FUNCTION__;
+
+    size_t begin = 0;
+    while (begin < prettyFunctionSize && function[begin] != '=') begin++;
+    begin += 2;
+
+    size_t end = prettyFunctionSize - 1;
+    while (end > begin && function[end] != ']') end--;
+
+    uint32_t hash = 2166136261u;
+    for (size_t i = begin; i < end; i++)
+    {
+        hash ^= static_cast<uint8_t>(function[i]);
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
 template <size_t A, size_t B>
 struct PowerOf
 {